@@ -0,0 +1,118 @@
+#include "AllocationCounter.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// Counters shared by every thread
+static std::atomic<size_t> allocationCount(0);
+static std::atomic<size_t> allocatedBytes(0);
+
+// Counts the allocation and allocates the memory, returns null if there is not enough memory
+static void* countedAllocate(size_t size, size_t alignment) {
+	allocationCount.fetch_add(1, std::memory_order_relaxed);
+	allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+	if (size == 0) {
+		size = 1;
+	}
+	if (alignment <= alignof(std::max_align_t)) {
+		return malloc(size);
+	}
+#if defined(_WIN32)
+	return _aligned_malloc(size, alignment);
+#else
+	void* memory = 0;
+	return posix_memalign(&memory, alignment, size) == 0 ? memory : 0;
+#endif
+}
+
+// Releases memory from countedAllocate
+static void countedFree(void* memory, size_t alignment) {
+#if defined(_WIN32)
+	if (alignment > alignof(std::max_align_t)) {
+		_aligned_free(memory);
+		return;
+	}
+#endif
+	(void) alignment;
+	free(memory);
+}
+
+size_t AllocationCounter::getAllocationCount() {
+	return allocationCount.load(std::memory_order_relaxed);
+}
+
+size_t AllocationCounter::getAllocatedBytes() {
+	return allocatedBytes.load(std::memory_order_relaxed);
+}
+
+void* operator new(size_t size) {
+	void* memory = countedAllocate(size, 0);
+	if (memory == 0) {
+		throw std::bad_alloc();
+	}
+	return memory;
+}
+
+void* operator new[](size_t size) {
+	return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+	return countedAllocate(size, 0);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+	return countedAllocate(size, 0);
+}
+
+void* operator new(size_t size, std::align_val_t alignment) {
+	void* memory = countedAllocate(size, (size_t) alignment);
+	if (memory == 0) {
+		throw std::bad_alloc();
+	}
+	return memory;
+}
+
+void* operator new[](size_t size, std::align_val_t alignment) {
+	return operator new(size, alignment);
+}
+
+void operator delete(void* memory) noexcept {
+	countedFree(memory, 0);
+}
+
+void operator delete[](void* memory) noexcept {
+	countedFree(memory, 0);
+}
+
+void operator delete(void* memory, size_t) noexcept {
+	countedFree(memory, 0);
+}
+
+void operator delete[](void* memory, size_t) noexcept {
+	countedFree(memory, 0);
+}
+
+void operator delete(void* memory, const std::nothrow_t&) noexcept {
+	countedFree(memory, 0);
+}
+
+void operator delete[](void* memory, const std::nothrow_t&) noexcept {
+	countedFree(memory, 0);
+}
+
+void operator delete(void* memory, std::align_val_t alignment) noexcept {
+	countedFree(memory, (size_t) alignment);
+}
+
+void operator delete[](void* memory, std::align_val_t alignment) noexcept {
+	countedFree(memory, (size_t) alignment);
+}
+
+void operator delete(void* memory, size_t, std::align_val_t alignment) noexcept {
+	countedFree(memory, (size_t) alignment);
+}
+
+void operator delete[](void* memory, size_t, std::align_val_t alignment) noexcept {
+	countedFree(memory, (size_t) alignment);
+}
@@ -0,0 +1,19 @@
+#ifndef ALLOCATION_COUNTER
+#define ALLOCATION_COUNTER
+
+#include <cstddef>
+
+// Counts the heap allocations of the process through the replaced global operator new
+// The counters only work in executables that link this file
+class AllocationCounter {
+public:
+
+	// Returns the number of allocations since the start of the process
+	static size_t getAllocationCount();
+
+	// Returns the number of bytes requested since the start of the process
+	static size_t getAllocatedBytes();
+
+};
+
+#endif
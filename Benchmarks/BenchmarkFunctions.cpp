@@ -0,0 +1,114 @@
+#include "BenchmarkFunctions.h"
+#include <algorithm>
+#include <sstream>
+#include <cstdlib>
+#include <cmath>
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+bool BenchmarkFunctions::parseCount(const std::string &text, size_t &count) {
+
+	// Read the numeric part of the text
+	char* end = 0;
+	double value = strtod(text.c_str(), &end);
+	if (end == text.c_str() || value <= 0) {
+		return false;
+	}
+
+	// Apply the multiplier of the suffix
+	std::string suffix(end);
+	if (suffix == "K" || suffix == "k") {
+		value *= 1e3;
+	} else if (suffix == "M" || suffix == "m") {
+		value *= 1e6;
+	} else if (!suffix.empty()) {
+		return false;
+	}
+
+	// Store the count
+	count = (size_t) value;
+	return true;
+}
+
+std::vector<std::string> BenchmarkFunctions::splitList(const std::string &text) {
+
+	// Read the items between the commas, skipping the empty ones
+	std::vector<std::string> items;
+	std::stringstream stream(text);
+	std::string item;
+	while (std::getline(stream, item, ',')) {
+		if (!item.empty()) {
+			items.push_back(item);
+		}
+	}
+
+	// Return the list of items
+	return items;
+}
+
+double BenchmarkFunctions::calculateMedian(std::vector<double> samples) {
+
+	// There is no median of an empty sample set
+	if (samples.empty()) {
+		return 0.0;
+	}
+
+	// Partially sort the samples around the middle element
+	size_t middle = samples.size() / 2;
+	std::nth_element(samples.begin(), samples.begin() + middle, samples.end());
+	double median = samples[middle];
+
+	// Average the two middle elements for even sample counts
+	if (samples.size() % 2 == 0) {
+		median = (median + *std::max_element(samples.begin(), samples.begin() + middle)) / 2;
+	}
+
+	// Return the median
+	return median;
+}
+
+double BenchmarkFunctions::calculateMedianAbsoluteDeviation(const std::vector<double> &samples) {
+
+	// Find the distance of every sample to the median
+	double median = calculateMedian(samples);
+	std::vector<double> deviations(samples.size());
+	for (size_t i = 0; i < samples.size(); i++) {
+		deviations[i] = std::abs(samples[i] - median);
+	}
+
+	// Return the median of the distances
+	return calculateMedian(deviations);
+}
+
+size_t BenchmarkFunctions::getPeakMemoryUsage() {
+
+#if defined(_WIN32)
+
+	// Windows reports the peak working set of the process
+	PROCESS_MEMORY_COUNTERS counters;
+	if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+		return (size_t) counters.PeakWorkingSetSize;
+	}
+	return 0;
+
+#else
+
+	// Other platforms report the maximum resident set size through the resource usage
+	struct rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) != 0) {
+		return 0;
+	}
+
+#if defined(__APPLE__)
+	return (size_t) usage.ru_maxrss;
+#else
+	return (size_t) usage.ru_maxrss * 1024;
+#endif
+
+#endif
+}
@@ -0,0 +1,28 @@
+#ifndef BENCHMARK_FUNCTIONS
+#define BENCHMARK_FUNCTIONS
+
+#include <vector>
+#include <string>
+#include <cstddef>
+
+class BenchmarkFunctions {
+public:
+
+	// Parses a count with an optional K or M suffix, returns false if the text is not a count
+	static bool parseCount(const std::string &text, size_t &count);
+
+	// Splits a comma separated list into its items
+	static std::vector<std::string> splitList(const std::string &text);
+
+	// Calculates the median of the given samples
+	static double calculateMedian(std::vector<double> samples);
+
+	// Calculates the median absolute deviation of the given samples from their median
+	static double calculateMedianAbsoluteDeviation(const std::vector<double> &samples);
+
+	// Returns the peak resident set size of the process in bytes, 0 if it is not available
+	static size_t getPeakMemoryUsage();
+
+};
+
+#endif
@@ -0,0 +1,359 @@
+#include "BenchmarkReport.h"
+#include "BenchmarkFunctions.h"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <limits>
+#include <cstdlib>
+#include <cmath>
+#include <cctype>
+
+// Scale factor that turns a median absolute deviation into a standard deviation estimate for normal noise
+#define MAD_SCALE 1.4826
+
+// Smallest number of repeated samples on both sides that allows a significance decision
+#define MINIMUM_SAMPLE_COUNT 3
+
+// Minimal reader for the subset of JSON written by the report
+class JsonReader {
+public:
+
+	JsonReader(const std::string &text) : text(text), position(0) {}
+
+	// Skips the whitespace before the next token
+	void skipWhitespace() {
+		while (position < text.size() && isspace((unsigned char) text[position])) {
+			position++;
+		}
+	}
+
+	// Consumes the given character if it is the next token
+	bool accept(char c) {
+		skipWhitespace();
+		if (position < text.size() && text[position] == c) {
+			position++;
+			return true;
+		}
+		return false;
+	}
+
+	// Reads a string token, escape sequences are kept as single characters
+	bool readString(std::string &value) {
+		if (!accept('"')) {
+			return false;
+		}
+		value.clear();
+		while (position < text.size() && text[position] != '"') {
+			if (text[position] == '\\') {
+				position++;
+			}
+			if (position < text.size()) {
+				value += text[position++];
+			}
+		}
+		return accept('"');
+	}
+
+	// Reads a number token, null is read as not-a-number
+	bool readNumber(double &value) {
+		skipWhitespace();
+		if (text.compare(position, 4, "null") == 0) {
+			position += 4;
+			value = std::numeric_limits<double>::quiet_NaN();
+			return true;
+		}
+		const char* start = text.c_str() + position;
+		char* end = 0;
+		value = strtod(start, &end);
+		if (end == start) {
+			return false;
+		}
+		position += end - start;
+		return true;
+	}
+
+	// Reads an array of numbers
+	bool readNumberArray(std::vector<double> &values) {
+		if (!accept('[')) {
+			return false;
+		}
+		values.clear();
+		if (accept(']')) {
+			return true;
+		}
+		do {
+			double value;
+			if (!readNumber(value)) {
+				return false;
+			}
+			values.push_back(value);
+		} while (accept(','));
+		return accept(']');
+	}
+
+	// Skips a value of any type
+	bool skipValue() {
+		skipWhitespace();
+		if (position >= text.size()) {
+			return false;
+		}
+		std::string string;
+		double number;
+		switch (text[position]) {
+		case '"':
+			return readString(string);
+		case '{':
+		case '[': {
+			char close = text[position] == '{' ? '}' : ']';
+			position++;
+			if (accept(close)) {
+				return true;
+			}
+			do {
+				if (close == '}' && (!readString(string) || !accept(':'))) {
+					return false;
+				}
+				if (!skipValue()) {
+					return false;
+				}
+			} while (accept(','));
+			return accept(close);
+		}
+		case 't':
+			position += 4;
+			return true;
+		case 'f':
+			position += 5;
+			return true;
+		default:
+			return readNumber(number);
+		}
+	}
+
+private:
+
+	const std::string &text;
+	size_t position;
+
+};
+
+// Writes a number, non-finite values are written as null since JSON cannot represent them
+static void writeNumber(std::ostream &stream, double value) {
+	if (std::isfinite(value)) {
+		stream << value;
+	} else {
+		stream << "null";
+	}
+}
+
+BenchmarkReport::BenchmarkReport(const std::string &name) {
+	this->name = name;
+}
+
+void BenchmarkReport::addSample(const std::string &measurement, double value) {
+	measurements[measurement].push_back(value);
+}
+
+void BenchmarkReport::setCounter(const std::string &counter, double value) {
+	counters[counter] = value;
+}
+
+bool BenchmarkReport::writeFile(const std::string &filepath) const {
+
+	// Open the file in given location
+	std::ofstream outfile(filepath);
+	if (!outfile) {
+		return false;
+	}
+	outfile << std::setprecision(10);
+
+	// Write the name of the benchmark
+	outfile << "{" << "\n";
+	outfile << "  \"benchmark\": \"" << name << "\"," << "\n";
+
+	// Write the samples of the measurements together with their summaries
+	outfile << "  \"measurements\": {";
+	for (std::map<std::string, std::vector<double> >::const_iterator it = measurements.begin(); it != measurements.end(); it++) {
+		outfile << (it == measurements.begin() ? "" : ",") << "\n";
+		outfile << "    \"" << it->first << "\": { \"median\": ";
+		writeNumber(outfile, BenchmarkFunctions::calculateMedian(it->second));
+		outfile << ", \"mad\": ";
+		writeNumber(outfile, BenchmarkFunctions::calculateMedianAbsoluteDeviation(it->second));
+		outfile << ", \"samples\": [";
+		for (size_t i = 0; i < it->second.size(); i++) {
+			outfile << (i == 0 ? "" : ", ");
+			writeNumber(outfile, it->second[i]);
+		}
+		outfile << "] }";
+	}
+	outfile << "\n" << "  }," << "\n";
+
+	// Write the counters
+	outfile << "  \"counters\": {";
+	for (std::map<std::string, double>::const_iterator it = counters.begin(); it != counters.end(); it++) {
+		outfile << (it == counters.begin() ? "" : ",") << "\n";
+		outfile << "    \"" << it->first << "\": ";
+		writeNumber(outfile, it->second);
+	}
+	outfile << "\n" << "  }" << "\n";
+	outfile << "}" << "\n";
+
+	// Close the output file
+	outfile.close();
+	return !outfile.fail();
+}
+
+bool BenchmarkReport::readFile(const std::string &filepath) {
+
+	// Read the whole file into memory
+	std::ifstream infile(filepath);
+	if (!infile) {
+		return false;
+	}
+	std::stringstream buffer;
+	buffer << infile.rdbuf();
+	const std::string text = buffer.str();
+
+	// Parse the top level object
+	measurements.clear();
+	counters.clear();
+	JsonReader reader(text);
+	if (!reader.accept('{')) {
+		return false;
+	}
+	do {
+
+		// Read the key of the member
+		std::string key;
+		if (!reader.readString(key) || !reader.accept(':')) {
+			return false;
+		}
+
+		// Read the members the report knows about and skip the rest
+		if (key == "benchmark") {
+			if (!reader.readString(name)) {
+				return false;
+			}
+		} else if (key == "measurements") {
+			if (!reader.accept('{')) {
+				return false;
+			}
+			if (!reader.accept('}')) {
+				do {
+
+					// Only the samples are needed, the summaries are recalculated
+					std::string measurement;
+					if (!reader.readString(measurement) || !reader.accept(':') || !reader.accept('{')) {
+						return false;
+					}
+					do {
+						std::string field;
+						if (!reader.readString(field) || !reader.accept(':')) {
+							return false;
+						}
+						if (field == "samples") {
+							if (!reader.readNumberArray(measurements[measurement])) {
+								return false;
+							}
+						} else if (!reader.skipValue()) {
+							return false;
+						}
+					} while (reader.accept(','));
+					if (!reader.accept('}')) {
+						return false;
+					}
+				} while (reader.accept(','));
+				if (!reader.accept('}')) {
+					return false;
+				}
+			}
+		} else if (key == "counters") {
+			if (!reader.accept('{')) {
+				return false;
+			}
+			if (!reader.accept('}')) {
+				do {
+					std::string counter;
+					double value;
+					if (!reader.readString(counter) || !reader.accept(':') || !reader.readNumber(value)) {
+						return false;
+					}
+					counters[counter] = value;
+				} while (reader.accept(','));
+				if (!reader.accept('}')) {
+					return false;
+				}
+			}
+		} else if (!reader.skipValue()) {
+			return false;
+		}
+	} while (reader.accept(','));
+
+	// Make sure the object is closed
+	return reader.accept('}');
+}
+
+size_t BenchmarkReport::compare(const BenchmarkReport &baseline, double threshold, double significance) const {
+
+	// Keep the stream format of the later output
+	std::ios::fmtflags flags = std::cout.flags();
+	std::streamsize precision = std::cout.precision();
+
+	// Print the header of the comparison table
+	std::cout << std::left << std::setw(48) << "measurement" << std::right << std::setw(14) << "baseline" << std::setw(14) << "current";
+	std::cout << std::setw(10) << "change" << std::setw(10) << "score" << "  verdict" << std::endl;
+
+	// Compare every measurement that exists in both reports
+	size_t regressionCount = 0;
+	for (std::map<std::string, std::vector<double> >::const_iterator it = measurements.begin(); it != measurements.end(); it++) {
+		std::map<std::string, std::vector<double> >::const_iterator match = baseline.measurements.find(it->first);
+		if (match == baseline.measurements.end()) {
+			continue;
+		}
+
+		// Summarize both sample sets with robust statistics
+		double currentMedian = BenchmarkFunctions::calculateMedian(it->second);
+		double baselineMedian = BenchmarkFunctions::calculateMedian(match->second);
+		double currentDeviation = BenchmarkFunctions::calculateMedianAbsoluteDeviation(it->second);
+		double baselineDeviation = BenchmarkFunctions::calculateMedianAbsoluteDeviation(match->second);
+
+		// Express the shift of the medians in units of the combined noise of both runs
+		double difference = currentMedian - baselineMedian;
+		double noise = MAD_SCALE * std::sqrt(currentDeviation * currentDeviation + baselineDeviation * baselineDeviation);
+		double score = noise > 0 ? difference / noise : (difference == 0 ? 0 : std::copysign(std::numeric_limits<double>::infinity(), difference));
+		double change = baselineMedian != 0 ? difference / baselineMedian : 0;
+
+		// A change has to be both large and well above the noise to count
+		const char* verdict = "unchanged";
+		if (it->second.size() < MINIMUM_SAMPLE_COUNT || match->second.size() < MINIMUM_SAMPLE_COUNT) {
+			verdict = "too few samples";
+		} else if (std::abs(change) > threshold && std::abs(score) > significance) {
+			if (difference > 0) {
+				verdict = "REGRESSION";
+				regressionCount++;
+			} else {
+				verdict = "improvement";
+			}
+		}
+
+		// Print the comparison of the measurement
+		std::cout << std::left << std::setw(48) << it->first << std::right << std::setprecision(6) << std::setw(14) << baselineMedian << std::setw(14) << currentMedian;
+		std::cout << std::fixed << std::setprecision(1) << std::setw(9) << change * 100 << "%" << std::setw(10) << score << "  " << verdict << std::endl;
+		std::cout.unsetf(std::ios::floatfield);
+	}
+
+	// Print the counters that changed
+	for (std::map<std::string, double>::const_iterator it = counters.begin(); it != counters.end(); it++) {
+		std::map<std::string, double>::const_iterator match = baseline.counters.find(it->first);
+		if (match != baseline.counters.end() && match->second != it->second) {
+			std::cout << std::left << std::setw(48) << it->first << std::right << std::setprecision(10) << std::setw(14) << match->second << std::setw(14) << it->second << std::endl;
+		}
+	}
+
+	// Print the summary
+	std::cout.flags(flags);
+	std::cout.precision(precision);
+	std::cout << "Significant regressions: " << regressionCount << std::endl;
+	return regressionCount;
+}
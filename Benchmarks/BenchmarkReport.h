@@ -0,0 +1,43 @@
+#ifndef BENCHMARK_REPORT
+#define BENCHMARK_REPORT
+
+#include <vector>
+#include <string>
+#include <map>
+#include <cstddef>
+
+class BenchmarkReport {
+public:
+
+	// Constructor
+	BenchmarkReport(const std::string &name = "");
+
+	// Adds a repeated sample of a timed measurement
+	void addSample(const std::string &measurement, double value);
+
+	// Sets the value of a counter such as an evaluation count or a matching percentage
+	void setCounter(const std::string &counter, double value);
+
+	// Writes the report into a JSON file, returns false if the file cannot be written
+	bool writeFile(const std::string &filepath) const;
+
+	// Reads a report written by writeFile, returns false if the file cannot be read or parsed
+	bool readFile(const std::string &filepath);
+
+	// Prints the differences to a baseline report and returns the number of significant regressions
+	size_t compare(const BenchmarkReport &baseline, double threshold, double significance) const;
+
+private:
+
+	// Name of the benchmark that produced the report
+	std::string name;
+
+	// Samples of each timed measurement
+	std::map<std::string, std::vector<double> > measurements;
+
+	// Values of the counters
+	std::map<std::string, double> counters;
+
+};
+
+#endif
@@ -0,0 +1,258 @@
+#include "QuadGenerator.h"
+#include "Timer.h"
+#include "BenchmarkFunctions.h"
+#include "BenchmarkReport.h"
+#include "AllocationCounter.h"
+#include "EvaluationFunctions.h"
+#include "BatchEvaluationFunctions.h"
+#include "GeometricFunctions.h"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cstdlib>
+
+// Settings of a benchmark run given from the command line
+struct BenchmarkSettings {
+	std::vector<QuadSet> sets;
+	size_t quadCount = 1000000;
+	size_t repetitions = 5;
+	unsigned int seed = 1;
+	std::string jsonFile;
+	std::string baselineFile;
+	double threshold = 0.05;
+	double significance = 3.0;
+};
+
+// Prevents the compiler from removing kernel calls whose results are otherwise unused
+static volatile double sink;
+
+// Number of kernels that allocated on the heap, the evaluations are expected to run on the stack only
+static size_t allocatingKernelCount = 0;
+
+// Adds the passes of a kernel to the report and prints the median and the best pass together with the heap allocations
+static void recordSamples(BenchmarkReport &report, const char* set, const std::string &name, const std::vector<double> &samples, size_t allocationCount) {
+
+	// Add the passes to the report
+	for (size_t r = 0; r < samples.size(); r++) {
+		report.addSample(std::string(set) + "/" + name, samples[r]);
+	}
+
+	// Print the median and the best pass
+	double median = BenchmarkFunctions::calculateMedian(samples);
+	double minimum = *std::min_element(samples.begin(), samples.end());
+	std::ios::fmtflags flags = std::cout.flags();
+	std::streamsize precision = std::cout.precision();
+	std::cout << std::left << std::setw(12) << set << std::setw(48) << name << std::right << std::fixed << std::setprecision(2);
+	std::cout << std::setw(10) << median << " ns/quad (median)" << std::setw(10) << minimum << " ns/quad (best)";
+	std::cout << std::setw(10) << allocationCount << " allocs" << std::endl;
+	std::cout.flags(flags);
+	std::cout.precision(precision);
+
+	// Keep the allocations in the report and remember the kernels that allocate
+	report.setCounter(std::string(set) + "/allocations/" + name, (double) allocationCount);
+	if (allocationCount > 0) {
+		allocatingKernelCount++;
+	}
+}
+
+// Runs a kernel over every quadrilateral of the set for the given number of repetitions and reports the time per quadrilateral
+template <typename Kernel>
+static void measureKernel(BenchmarkReport &report, const char* set, const char* name, const std::vector<Quadrilateral> &quads, size_t repetitions, Kernel kernel) {
+
+	// Time each pass over the whole set separately
+	std::vector<double> samples;
+	samples.reserve(repetitions);
+	size_t allocationCount = AllocationCounter::getAllocationCount();
+	for (size_t r = 0; r < repetitions; r++) {
+		Timer timer;
+		double sum = 0.0;
+		for (size_t i = 0; i < quads.size(); i++) {
+			sum += kernel(quads[i]);
+		}
+		samples.push_back(timer.getElapsedSeconds() * 1e9 / quads.size());
+		sink = sum;
+	}
+	allocationCount = AllocationCounter::getAllocationCount() - allocationCount;
+
+	// Report the passes
+	recordSamples(report, set, name, samples, allocationCount);
+}
+
+// Runs a batch kernel over the whole set for the given number of repetitions and reports the time per quadrilateral
+static void measureBatchKernel(BenchmarkReport &report, const char* set, const std::string &name, const QuadBatch &batch, size_t repetitions, void (*kernel)(const QuadBatch&, float*)) {
+
+	// Time each pass over the whole batch separately
+	std::vector<float> results(batch.getSize());
+	std::vector<double> samples;
+	samples.reserve(repetitions);
+	size_t allocationCount = AllocationCounter::getAllocationCount();
+	for (size_t r = 0; r < repetitions; r++) {
+		Timer timer;
+		kernel(batch, results.data());
+		samples.push_back(timer.getElapsedSeconds() * 1e9 / batch.getSize());
+		sink = results.empty() ? 0.0 : results[r % results.size()];
+	}
+	allocationCount = AllocationCounter::getAllocationCount() - allocationCount;
+
+	// Report the passes
+	recordSamples(report, set, name, samples, allocationCount);
+}
+
+// Prints the command line usage
+static void printUsage() {
+	std::cout << "Usage: KernelBenchmark [options]" << std::endl;
+	std::cout << "  --sets LIST         comma separated list of random, planar, concave, degenerate (default: all)" << std::endl;
+	std::cout << "  --count N           quadrilaterals per set, K and M suffixes allowed (default: 1M)" << std::endl;
+	std::cout << "  --repetitions N     passes over each set (default: 5)" << std::endl;
+	std::cout << "  --seed N            seed of the quadrilateral generator (default: 1)" << std::endl;
+	std::cout << "  --json FILE         write the results into a JSON file" << std::endl;
+	std::cout << "  --compare FILE      compare the results to a baseline JSON file" << std::endl;
+	std::cout << "  --threshold R       smallest relative slowdown reported as a regression (default: 0.05)" << std::endl;
+	std::cout << "  --significance Z    smallest median shift in units of MAD noise reported as a regression (default: 3)" << std::endl;
+}
+
+// Parses the command line into the benchmark settings
+static bool parseArguments(int argc, char **argv, BenchmarkSettings &settings) {
+
+	// Read the options one by one
+	for (int i = 1; i < argc; i++) {
+		std::string argument = argv[i];
+		if (argument == "--sets" && i + 1 < argc) {
+			std::vector<std::string> names = BenchmarkFunctions::splitList(argv[++i]);
+			for (size_t j = 0; j < names.size(); j++) {
+				QuadSet set;
+				if (!QuadGenerator::parseSet(names[j], set)) {
+					std::cerr << "Unknown set: " << names[j] << std::endl;
+					return false;
+				}
+				settings.sets.push_back(set);
+			}
+		} else if (argument == "--count" && i + 1 < argc) {
+			if (!BenchmarkFunctions::parseCount(argv[++i], settings.quadCount)) {
+				return false;
+			}
+		} else if (argument == "--repetitions" && i + 1 < argc) {
+			if (!BenchmarkFunctions::parseCount(argv[++i], settings.repetitions)) {
+				return false;
+			}
+		} else if (argument == "--seed" && i + 1 < argc) {
+			settings.seed = (unsigned int) std::stoul(argv[++i]);
+		} else if (argument == "--json" && i + 1 < argc) {
+			settings.jsonFile = argv[++i];
+		} else if (argument == "--compare" && i + 1 < argc) {
+			settings.baselineFile = argv[++i];
+		} else if (argument == "--threshold" && i + 1 < argc) {
+			settings.threshold = atof(argv[++i]);
+		} else if (argument == "--significance" && i + 1 < argc) {
+			settings.significance = atof(argv[++i]);
+		} else {
+			return false;
+		}
+	}
+
+	// Use every set if none is given
+	if (settings.sets.empty()) {
+		settings.sets.push_back(RANDOM_QUADS);
+		settings.sets.push_back(PLANAR_QUADS);
+		settings.sets.push_back(CONCAVE_QUADS);
+		settings.sets.push_back(DEGENERATE_QUADS);
+	}
+
+	return true;
+}
+
+int main(int argc, char **argv) {
+
+	// Read the benchmark settings from the command line
+	BenchmarkSettings settings;
+	if (!parseArguments(argc, argv, settings)) {
+		printUsage();
+		return 1;
+	}
+
+	// Measure every kernel on every quadrilateral set
+	BenchmarkReport report("KernelBenchmark");
+	for (size_t i = 0; i < settings.sets.size(); i++) {
+
+		// Generate the quadrilaterals of the set
+		const char* setName = QuadGenerator::getSetName(settings.sets[i]);
+		std::vector<Quadrilateral> quads;
+		QuadGenerator::generateQuads(settings.sets[i], settings.quadCount, settings.seed, quads);
+
+		// Quality metrics of the evaluation functions
+		measureKernel(report, setName, "calculateMaximumWarpage", quads, settings.repetitions, [](const Quadrilateral &quad) {
+			return EvaluationFunctions::calculateMaximumWarpage(quad);
+		});
+		measureKernel(report, setName, "calculateMinimumScaledJacobian", quads, settings.repetitions, [](const Quadrilateral &quad) {
+			return EvaluationFunctions::calculateMinimumScaledJacobian(quad);
+		});
+		measureKernel(report, setName, "calculateDistortion", quads, settings.repetitions, [](const Quadrilateral &quad) {
+			return EvaluationFunctions::calculateDistortion(quad);
+		});
+		measureKernel(report, setName, "calculateDistortion2", quads, settings.repetitions, [](const Quadrilateral &quad) {
+			return EvaluationFunctions::calculateDistortion2(quad);
+		});
+		measureKernel(report, setName, "calculateAspectRatio", quads, settings.repetitions, [](const Quadrilateral &quad) {
+			return EvaluationFunctions::calculateAspectRatio(quad);
+		});
+
+		// Geometric helpers on the edges and diagonals of the quadrilateral
+		measureKernel(report, setName, "findNormal", quads, settings.repetitions, [](const Quadrilateral &quad) {
+			const Normal normal = GeometricFunctions::findNormal(Vec3(quad.a, quad.b), Vec3(quad.a, quad.d));
+			return normal.x;
+		});
+		measureKernel(report, setName, "calculateAngle", quads, settings.repetitions, [](const Quadrilateral &quad) {
+			return GeometricFunctions::calculateAngle(Vec3(quad.a, quad.b), Vec3(quad.a, quad.d));
+		});
+		measureKernel(report, setName, "checkLineIntersection", quads, settings.repetitions, [](const Quadrilateral &quad) {
+			return GeometricFunctions::checkLineIntersection(quad.a, quad.c, quad.b, quad.d) ? 1.0 : 0.0;
+		});
+
+		// Batch kernels of every instruction set that the processor supports
+		QuadBatch batch;
+		batch.resize(quads.size());
+		for (size_t j = 0; j < quads.size(); j++) {
+			batch.set(j, quads[j].a, quads[j].b, quads[j].c, quads[j].d);
+		}
+		InstructionSet defaultInstructionSet = BatchEvaluationFunctions::getInstructionSet();
+		const InstructionSet instructionSets[] = { GENERIC_INSTRUCTIONS, SSE42_INSTRUCTIONS, AVX2_INSTRUCTIONS, AVX512_INSTRUCTIONS };
+		for (size_t j = 0; j < sizeof(instructionSets) / sizeof(instructionSets[0]); j++) {
+			if (!BatchEvaluationFunctions::setInstructionSet(instructionSets[j])) {
+				continue;
+			}
+			std::string prefix = std::string("batch/") + BatchEvaluationFunctions::getInstructionSetName(instructionSets[j]) + "/";
+			measureBatchKernel(report, setName, prefix + "calculateMaximumWarpage", batch, settings.repetitions, BatchEvaluationFunctions::calculateMaximumWarpage);
+			measureBatchKernel(report, setName, prefix + "calculateMinimumScaledJacobian", batch, settings.repetitions, BatchEvaluationFunctions::calculateMinimumScaledJacobian);
+			measureBatchKernel(report, setName, prefix + "calculateDistortion", batch, settings.repetitions, BatchEvaluationFunctions::calculateDistortion);
+			measureBatchKernel(report, setName, prefix + "calculateDistortion2", batch, settings.repetitions, BatchEvaluationFunctions::calculateDistortion2);
+			measureBatchKernel(report, setName, prefix + "calculateAspectRatio", batch, settings.repetitions, BatchEvaluationFunctions::calculateAspectRatio);
+		}
+		BatchEvaluationFunctions::setInstructionSet(defaultInstructionSet);
+	}
+
+	// Write the results into the JSON file
+	if (!settings.jsonFile.empty() && !report.writeFile(settings.jsonFile)) {
+		std::cerr << "Cannot write " << settings.jsonFile << std::endl;
+		return 1;
+	}
+
+	// Compare the results to the baseline, regressions make the run fail
+	if (!settings.baselineFile.empty()) {
+		BenchmarkReport baseline;
+		if (!baseline.readFile(settings.baselineFile)) {
+			std::cerr << "Cannot read " << settings.baselineFile << std::endl;
+			return 1;
+		}
+		if (report.compare(baseline, settings.threshold, settings.significance) > 0) {
+			return 2;
+		}
+	}
+
+	// Kernels that allocate on the heap break the zero-allocation guarantee of the evaluations
+	if (allocatingKernelCount > 0) {
+		std::cerr << allocatingKernelCount << " kernels allocated on the heap" << std::endl;
+		return 3;
+	}
+
+	return 0;
+}
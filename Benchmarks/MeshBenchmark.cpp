@@ -0,0 +1,366 @@
+#include "MeshGenerator.h"
+#include "Timer.h"
+#include "AllocationCounter.h"
+#include "BenchmarkFunctions.h"
+#include "BenchmarkReport.h"
+#include "MeshReader.h"
+#include "MeshBuilder.h"
+#include "MeshWriter.h"
+#include "QualityReport.h"
+#include "ParallelFunctions.h"
+#include <iostream>
+#include <iomanip>
+#include <cstdio>
+#include <cstdlib>
+#include <utility>
+
+// Settings of a benchmark run given from the command line
+struct BenchmarkSettings {
+	std::vector<MeshShape> shapes;
+	std::vector<size_t> sizes;
+	std::string directory = ".";
+	bool keepFiles = false;
+	size_t repetitions = 1;
+	QueueType queueType = INDEXED_HEAP;
+	MatchingType matchingType = GREEDY_ENGINE;
+	unsigned int repairHops = 0;
+	double repairCap = 90.0;
+	double repairBudget = 1.0;
+	std::string jsonFile;
+	std::string baselineFile;
+	double threshold = 0.05;
+	double significance = 3.0;
+};
+
+// Prints the command line usage
+static void printUsage() {
+	std::cout << "Usage: MeshBenchmark [options]" << std::endl;
+	std::cout << "  --shapes LIST     comma separated list of torus, icosphere, noisy-sphere, warped-torus (default: all)" << std::endl;
+	std::cout << "  --sizes LIST      comma separated triangle counts, K and M suffixes allowed (default: 10K,100K,1M)" << std::endl;
+	std::cout << "  --directory DIR   directory for the intermediate mesh files (default: .)" << std::endl;
+	std::cout << "  --keep-files      do not delete the intermediate mesh files" << std::endl;
+	std::cout << "  --repetitions N   runs of the pipeline on each mesh (default: 1)" << std::endl;
+	std::cout << "  --threads N       worker threads of the parallel stages (default: all hardware threads)" << std::endl;
+	std::cout << "  --queue NAME      face queue of the matching: lazy, indexed or bucket (default: indexed)" << std::endl;
+	std::cout << "  --engine NAME     matching engine: greedy, dominant, stealing, partitioned, optimal or sorted, other engines are compared to greedy (default: greedy)" << std::endl;
+	std::cout << "  --repair-hops N   longest augmenting path of the repair after the matching, 0 disables the repair (default: 0)" << std::endl;
+	std::cout << "  --repair-cap DEG  largest warpage of a pair added by the repair (default: 90)" << std::endl;
+	std::cout << "  --repair-budget S time budget of the repair in seconds (default: 1)" << std::endl;
+	std::cout << "  --json FILE       write the results into a JSON file" << std::endl;
+	std::cout << "  --compare FILE    compare the results to a baseline JSON file" << std::endl;
+	std::cout << "  --threshold R     smallest relative slowdown reported as a regression (default: 0.05)" << std::endl;
+	std::cout << "  --significance Z  smallest median shift in units of MAD noise reported as a regression (default: 3)" << std::endl;
+}
+
+// Parses the command line into the benchmark settings
+static bool parseArguments(int argc, char **argv, BenchmarkSettings &settings) {
+
+	// Read the options one by one
+	for (int i = 1; i < argc; i++) {
+		std::string argument = argv[i];
+		if (argument == "--shapes" && i + 1 < argc) {
+			std::vector<std::string> names = BenchmarkFunctions::splitList(argv[++i]);
+			for (size_t j = 0; j < names.size(); j++) {
+				MeshShape shape;
+				if (!MeshGenerator::parseShape(names[j], shape)) {
+					std::cerr << "Unknown shape: " << names[j] << std::endl;
+					return false;
+				}
+				settings.shapes.push_back(shape);
+			}
+		} else if (argument == "--sizes" && i + 1 < argc) {
+			std::vector<std::string> sizes = BenchmarkFunctions::splitList(argv[++i]);
+			for (size_t j = 0; j < sizes.size(); j++) {
+				size_t size;
+				if (!BenchmarkFunctions::parseCount(sizes[j], size)) {
+					std::cerr << "Invalid size: " << sizes[j] << std::endl;
+					return false;
+				}
+				settings.sizes.push_back(size);
+			}
+		} else if (argument == "--directory" && i + 1 < argc) {
+			settings.directory = argv[++i];
+		} else if (argument == "--keep-files") {
+			settings.keepFiles = true;
+		} else if (argument == "--repetitions" && i + 1 < argc) {
+			if (!BenchmarkFunctions::parseCount(argv[++i], settings.repetitions)) {
+				return false;
+			}
+		} else if (argument == "--threads" && i + 1 < argc) {
+			ParallelFunctions::setThreadCount((unsigned int) atoi(argv[++i]));
+		} else if (argument == "--queue" && i + 1 < argc) {
+			if (!FaceQueue::parseType(argv[++i], settings.queueType)) {
+				std::cerr << "Unknown queue: " << argv[i] << std::endl;
+				return false;
+			}
+		} else if (argument == "--engine" && i + 1 < argc) {
+			if (!MatchingEngine::parseType(argv[++i], settings.matchingType)) {
+				std::cerr << "Unknown engine: " << argv[i] << std::endl;
+				return false;
+			}
+		} else if (argument == "--repair-hops" && i + 1 < argc) {
+			settings.repairHops = (unsigned int) atoi(argv[++i]);
+		} else if (argument == "--repair-cap" && i + 1 < argc) {
+			settings.repairCap = atof(argv[++i]);
+		} else if (argument == "--repair-budget" && i + 1 < argc) {
+			settings.repairBudget = atof(argv[++i]);
+		} else if (argument == "--json" && i + 1 < argc) {
+			settings.jsonFile = argv[++i];
+		} else if (argument == "--compare" && i + 1 < argc) {
+			settings.baselineFile = argv[++i];
+		} else if (argument == "--threshold" && i + 1 < argc) {
+			settings.threshold = atof(argv[++i]);
+		} else if (argument == "--significance" && i + 1 < argc) {
+			settings.significance = atof(argv[++i]);
+		} else {
+			return false;
+		}
+	}
+
+	// Use every shape if none is given
+	if (settings.shapes.empty()) {
+		settings.shapes.push_back(TORUS);
+		settings.shapes.push_back(ICOSPHERE);
+		settings.shapes.push_back(NOISY_SPHERE);
+		settings.shapes.push_back(WARPED_TORUS);
+	}
+
+	// Use the default sizes if none is given
+	if (settings.sizes.empty()) {
+		settings.sizes.push_back(10000);
+		settings.sizes.push_back(100000);
+		settings.sizes.push_back(1000000);
+	}
+
+	return true;
+}
+
+// Measures the wall-clock time and the heap allocations of a stage
+class StageMeasurement {
+public:
+
+	// Constructor, starts the measurement
+	StageMeasurement() {
+		reset();
+	}
+
+	// Restarts the measurement
+	void reset() {
+		allocationCount = AllocationCounter::getAllocationCount();
+		timer.reset();
+	}
+
+	// Returns the wall-clock time passed since the last reset in seconds
+	double getElapsedSeconds() const {
+		return timer.getElapsedSeconds();
+	}
+
+	// Returns the number of allocations since the last reset
+	size_t getAllocationCount() const {
+		return AllocationCounter::getAllocationCount() - allocationCount;
+	}
+
+private:
+
+	Timer timer;
+	size_t allocationCount;
+
+};
+
+// Prints the timing and allocation count of a single stage and adds them to the report
+static void recordStage(BenchmarkReport &report, const std::string &prefix, const char* shape, size_t faceCount, const char* stage, const StageMeasurement &measurement) {
+	double seconds = measurement.getElapsedSeconds();
+	size_t allocationCount = measurement.getAllocationCount();
+
+	// Keep the stream format of the later output
+	std::ios::fmtflags flags = std::cout.flags();
+	std::streamsize precision = std::cout.precision();
+	std::cout << std::left << std::setw(14) << shape << std::right << std::setw(12) << faceCount << "  " << std::left << std::setw(18) << stage;
+	std::cout << std::right << std::fixed << std::setprecision(4) << std::setw(10) << seconds << " s";
+	std::cout << std::setprecision(2) << std::setw(10) << faceCount / seconds / 1e6 << " Mtri/s";
+	std::cout << std::setw(12) << allocationCount << " allocs" << std::endl;
+	std::cout.flags(flags);
+	std::cout.precision(precision);
+	report.addSample(prefix + stage, seconds);
+	report.setCounter(prefix + "allocations/" + stage, (double) allocationCount);
+}
+
+// Matches the mesh with the greedy engine and reports the matching percentage of the measured engine or repair against it
+static void recordGreedyReference(BenchmarkReport &report, const std::string &prefix, const TriangularMesh* mesh, QueueType queueType, double matchingPercentage) {
+	MeshBuilder reference(mesh, queueType, GREEDY_ENGINE);
+	reference.calculateMatching();
+	double greedyPercentage = reference.getStatistics().at("matchingPercentage");
+	std::cout << "Matching percentage difference to greedy: " << matchingPercentage - greedyPercentage << std::endl;
+	report.setCounter(prefix + "greedyMatchingPercentage", greedyPercentage);
+	report.setCounter(prefix + "matchingPercentageDifference", matchingPercentage - greedyPercentage);
+}
+
+int main(int argc, char **argv) {
+
+	// Read the benchmark settings from the command line
+	BenchmarkSettings settings;
+	if (!parseArguments(argc, argv, settings)) {
+		printUsage();
+		return 1;
+	}
+
+	// Run the whole pipeline for each shape and size
+	BenchmarkReport report("MeshBenchmark");
+	for (size_t i = 0; i < settings.shapes.size(); i++) {
+		for (size_t j = 0; j < settings.sizes.size(); j++) {
+
+			// Find the file names for the current mesh
+			const char* shapeName = MeshGenerator::getShapeName(settings.shapes[i]);
+			std::string basename = settings.directory + "/" + shapeName + "-" + std::to_string(settings.sizes[j]);
+			std::string inputFile = basename + ".off";
+			std::string binaryFile = basename + ".wbm";
+			std::string outputFile = basename + "-quad.off";
+			std::string binaryOutputFile = basename + "-quad.wbm";
+
+			// Measurements of the mesh are named after its shape and requested size
+			std::string prefix = std::string(shapeName) + "/" + std::to_string(settings.sizes[j]) + "/";
+
+			// Generate the mesh in memory
+			StageMeasurement timer;
+			std::vector<Vertex> vertices;
+			std::vector<Face> faces;
+			MeshGenerator::generateMesh(settings.shapes[i], settings.sizes[j], vertices, faces);
+			size_t faceCount = faces.size();
+			recordStage(report, prefix, shapeName, faceCount, "generate", timer);
+
+			// Write the generated mesh so that the reader can be measured
+			timer.reset();
+			MeshGenerator::writeMesh(inputFile, vertices, faces);
+			recordStage(report, prefix, shapeName, faceCount, "serialize", timer);
+
+			// Write the same mesh in the binary format
+			timer.reset();
+			if (!MeshWriter::getInstance()->writeBinaryMesh(binaryFile, vertices, faces)) {
+				std::cerr << "Cannot write " << binaryFile << std::endl;
+				return 1;
+			}
+			recordStage(report, prefix, shapeName, faceCount, "serialize-binary", timer);
+
+			// Repeat the measured part of the pipeline
+			for (size_t r = 0; r < settings.repetitions; r++) {
+
+				// Measure the half-edge construction alone, the mesh takes over copies of the lists
+				std::vector<Vertex> vertexList(vertices);
+				std::vector<Face> faceList(faces);
+				timer.reset();
+				const TriangularMesh* constructed = new TriangularMesh(std::move(vertexList), std::move(faceList));
+				recordStage(report, prefix, shapeName, faceCount, "construct", timer);
+				delete constructed;
+
+				// Read the binary mesh, the construction works on the mapped blocks
+				timer.reset();
+				const TriangularMesh* binaryMesh = MeshReader::getInstance()->readMesh(binaryFile);
+				if (binaryMesh == NULL) {
+					return 1;
+				}
+				recordStage(report, prefix, shapeName, faceCount, "read-binary", timer);
+				delete binaryMesh;
+
+				// Read the mesh back, this includes the half-edge construction
+				timer.reset();
+				const TriangularMesh* mesh = MeshReader::getInstance()->readMesh(inputFile);
+				if (mesh == NULL) {
+					return 1;
+				}
+				recordStage(report, prefix, shapeName, faceCount, "read", timer);
+
+				// Initialize the priorities of the faces
+				timer.reset();
+				MeshBuilder* builder = new MeshBuilder(mesh, settings.queueType, settings.matchingType);
+				recordStage(report, prefix, shapeName, faceCount, "initialize", timer);
+
+				// Calculate the matching
+				timer.reset();
+				builder->calculateMatching();
+				recordStage(report, prefix, shapeName, faceCount, "match", timer);
+
+				// Pair the unmatched faces along augmenting paths
+				if (settings.repairHops > 0) {
+					timer.reset();
+					builder->repairMatching(settings.repairHops, settings.repairCap, settings.repairBudget);
+					recordStage(report, prefix, shapeName, faceCount, "repair", timer);
+				}
+
+				// Evaluate the quality of the quadrilaterals
+				timer.reset();
+				const QualityReport quality(mesh, builder->getMatching());
+				recordStage(report, prefix, shapeName, faceCount, "report", timer);
+
+				// Write the quadrilateral mesh
+				timer.reset();
+				if (!MeshWriter::getInstance()->writeMesh(outputFile, mesh, builder->getMatching())) {
+					std::cerr << "Cannot write " << outputFile << std::endl;
+					return 1;
+				}
+				recordStage(report, prefix, shapeName, faceCount, "write", timer);
+
+				// Write the quadrilateral mesh in the binary format
+				timer.reset();
+				if (!MeshWriter::getInstance()->writeBinaryQuadMesh(binaryOutputFile, mesh, builder->getMatching(), builder->getUnmatchedFaces())) {
+					std::cerr << "Cannot write " << binaryOutputFile << std::endl;
+					return 1;
+				}
+				recordStage(report, prefix, shapeName, faceCount, "write-binary", timer);
+
+				// Store the statistics of the matching, they are the same for every repetition
+				const std::map<std::string, double> &statistics = builder->getStatistics();
+				for (std::map<std::string, double>::const_iterator it = statistics.begin(); it != statistics.end(); it++) {
+					report.setCounter(prefix + it->first, it->second);
+				}
+				for (int i = 0; i < QUALITY_METRIC_COUNT; i++) {
+					const MetricSummary &summary = quality.getSummary((QualityMetric) i);
+					report.setCounter(prefix + "quality/" + QualityReport::getMetricName((QualityMetric) i) + "/mean", summary.mean);
+					report.setCounter(prefix + "quality/" + QualityReport::getMetricName((QualityMetric) i) + "/maximum", summary.maximum);
+				}
+				report.setCounter(prefix + "faceCount", (double) faceCount);
+				if (settings.matchingType != GREEDY_ENGINE || settings.repairHops > 0) {
+					recordGreedyReference(report, prefix, mesh, settings.queueType, statistics.at("matchingPercentage"));
+				}
+				report.setCounter(prefix + "boundaryEdgeCount", (double) mesh->getBoundaryEdgeCount());
+				report.setCounter(prefix + "nonManifoldEdgeCount", (double) mesh->getNonManifoldEdgeCount());
+
+				// Delete the builder and the mesh
+				timer.reset();
+				delete builder;
+				delete mesh;
+				recordStage(report, prefix, shapeName, faceCount, "teardown", timer);
+			}
+
+			// Peak memory usage of the process so far, it only grows with the mesh sizes
+			report.setCounter(prefix + "peakMemoryBytes", (double) BenchmarkFunctions::getPeakMemoryUsage());
+
+			// Remove the intermediate files
+			if (!settings.keepFiles) {
+				std::remove(inputFile.c_str());
+				std::remove(binaryFile.c_str());
+				std::remove(outputFile.c_str());
+				std::remove(binaryOutputFile.c_str());
+			}
+		}
+	}
+
+	// Write the results into the JSON file
+	if (!settings.jsonFile.empty() && !report.writeFile(settings.jsonFile)) {
+		std::cerr << "Cannot write " << settings.jsonFile << std::endl;
+		return 1;
+	}
+
+	// Compare the results to the baseline, regressions make the run fail
+	if (!settings.baselineFile.empty()) {
+		BenchmarkReport baseline;
+		if (!baseline.readFile(settings.baselineFile)) {
+			std::cerr << "Cannot read " << settings.baselineFile << std::endl;
+			return 1;
+		}
+		if (report.compare(baseline, settings.threshold, settings.significance) > 0) {
+			return 2;
+		}
+	}
+
+	return 0;
+}
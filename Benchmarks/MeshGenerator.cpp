@@ -0,0 +1,259 @@
+#include "MeshGenerator.h"
+#include "Definitions.h"
+#include <algorithm>
+#include <fstream>
+#include <random>
+#include <cmath>
+#include <map>
+
+#define PI 3.14159265358979323846
+
+// Vertex coordinates of a regular icosahedron, golden ratio is used for the long sides
+static const double ICOSAHEDRON_VERTICES[12][3] = {
+	{ -1, 1.618033988749895, 0 }, { 1, 1.618033988749895, 0 }, { -1, -1.618033988749895, 0 }, { 1, -1.618033988749895, 0 },
+	{ 0, -1, 1.618033988749895 }, { 0, 1, 1.618033988749895 }, { 0, -1, -1.618033988749895 }, { 0, 1, -1.618033988749895 },
+	{ 1.618033988749895, 0, -1 }, { 1.618033988749895, 0, 1 }, { -1.618033988749895, 0, -1 }, { -1.618033988749895, 0, 1 }
+};
+
+// Faces of the icosahedron in counter-clockwise order when looked from outside
+static const unsigned int ICOSAHEDRON_FACES[20][3] = {
+	{ 0, 11, 5 }, { 0, 5, 1 }, { 0, 1, 7 }, { 0, 7, 10 }, { 0, 10, 11 },
+	{ 1, 5, 9 }, { 5, 11, 4 }, { 11, 10, 2 }, { 10, 7, 6 }, { 7, 1, 8 },
+	{ 3, 9, 4 }, { 3, 4, 2 }, { 3, 2, 6 }, { 3, 6, 8 }, { 3, 8, 9 },
+	{ 4, 9, 5 }, { 2, 4, 11 }, { 6, 2, 10 }, { 8, 6, 7 }, { 9, 8, 1 }
+};
+
+void MeshGenerator::generateMesh(MeshShape shape, size_t triangleCount, std::vector<Vertex> &vertices, std::vector<Face> &faces, unsigned int seed) {
+
+	// Forward the request to the generator of the shape family
+	switch (shape) {
+	case TORUS:
+		generateTorus(triangleCount, 0.0, vertices, faces);
+		break;
+	case ICOSPHERE:
+		generateIcosphere(triangleCount, 0.0, seed, vertices, faces);
+		break;
+	case NOISY_SPHERE:
+		generateIcosphere(triangleCount, 0.25, seed, vertices, faces);
+		break;
+	case WARPED_TORUS:
+		generateTorus(triangleCount, 0.4, vertices, faces);
+		break;
+	}
+}
+
+void MeshGenerator::generateTorus(size_t triangleCount, double warpAmplitude, std::vector<Vertex> &vertices, std::vector<Face> &faces) {
+
+	// Major radius is three times the minor one, so keep the same ratio between the segment counts
+	const double majorRadius = 3.0;
+	const double minorRadius = 1.0;
+	size_t minorSegments = std::max<size_t>(3, (size_t) std::sqrt(triangleCount / 6.0));
+	size_t majorSegments = std::max<size_t>(3, triangleCount / (2 * minorSegments));
+
+	// Create the vertices of the grid wrapped around both circles
+	vertices.clear();
+	vertices.reserve(majorSegments * minorSegments);
+	for (size_t i = 0; i < majorSegments; i++) {
+		double u = 2.0 * PI * i / majorSegments;
+		for (size_t j = 0; j < minorSegments; j++) {
+			double v = 2.0 * PI * j / minorSegments;
+
+			// Displace the tube radius with a low frequency wave to get non-planar quads
+			double radius = minorRadius * (1.0 + warpAmplitude * std::sin(7.0 * u) * std::sin(3.0 * v));
+
+			// Calculate the position on the torus surface
+			double x = (majorRadius + radius * std::cos(v)) * std::cos(u);
+			double y = (majorRadius + radius * std::cos(v)) * std::sin(u);
+			double z = radius * std::sin(v);
+			vertices.push_back(Vertex((float) x, (float) y, (float) z));
+		}
+	}
+
+	// Split each grid cell into two consistently oriented triangles
+	faces.clear();
+	faces.reserve(2 * majorSegments * minorSegments);
+	for (size_t i = 0; i < majorSegments; i++) {
+		size_t nextI = (i + 1) % majorSegments;
+		for (size_t j = 0; j < minorSegments; j++) {
+			size_t nextJ = (j + 1) % minorSegments;
+
+			// Find the corners of the current cell
+			unsigned int a = (unsigned int) (i * minorSegments + j);
+			unsigned int b = (unsigned int) (nextI * minorSegments + j);
+			unsigned int c = (unsigned int) (nextI * minorSegments + nextJ);
+			unsigned int d = (unsigned int) (i * minorSegments + nextJ);
+
+			// Add the triangles of the cell
+			faces.push_back(Face(a, b, c));
+			faces.push_back(Face(a, c, d));
+		}
+	}
+}
+
+void MeshGenerator::generateIcosphere(size_t triangleCount, double noiseAmplitude, unsigned int seed, std::vector<Vertex> &vertices, std::vector<Face> &faces) {
+
+	// Each icosahedron face is split into frequency^2 triangles
+	const unsigned int frequency = std::max(1u, (unsigned int) std::lround(std::sqrt(triangleCount / 20.0)));
+
+	// Number the icosahedron edges, interior vertices of each edge are stored from the lower vertex id
+	std::map<VertexPair, unsigned int> edgeIds;
+	for (unsigned int f = 0; f < 20; f++) {
+		for (unsigned int k = 0; k < 3; k++) {
+			unsigned int u = ICOSAHEDRON_FACES[f][k];
+			unsigned int v = ICOSAHEDRON_FACES[f][(k + 1) % 3];
+			VertexPair key = std::make_pair(std::min(u, v), std::max(u, v));
+			if (edgeIds.find(key) == edgeIds.end()) {
+				unsigned int id = (unsigned int) edgeIds.size();
+				edgeIds[key] = id;
+			}
+		}
+	}
+
+	// Vertex blocks are the corners, then the edge interiors, then the face interiors
+	const unsigned int edgeBase = 12;
+	const unsigned int edgeStride = frequency - 1;
+	const unsigned int faceBase = edgeBase + 30 * edgeStride;
+	const unsigned int faceStride = frequency > 2 ? (frequency - 1) * (frequency - 2) / 2 : 0;
+
+	// Find the first interior index on each row of a face grid
+	std::vector<unsigned int> rowStart(frequency + 1, 0);
+	for (unsigned int i = 2; i <= frequency; i++) {
+		rowStart[i] = rowStart[i - 1] + (frequency - i);
+	}
+
+	// Create every vertex once, shared vertices are simply overwritten with the same position
+	vertices.assign(faceBase + 20 * faceStride, Vertex());
+	faces.clear();
+	faces.reserve(20 * (size_t) frequency * frequency);
+	std::vector<unsigned int> grid((frequency + 1) * (frequency + 1));
+	for (unsigned int f = 0; f < 20; f++) {
+
+		// Get the corners of the icosahedron face
+		const unsigned int corners[3] = { ICOSAHEDRON_FACES[f][0], ICOSAHEDRON_FACES[f][1], ICOSAHEDRON_FACES[f][2] };
+		const double* a = ICOSAHEDRON_VERTICES[corners[0]];
+		const double* b = ICOSAHEDRON_VERTICES[corners[1]];
+		const double* c = ICOSAHEDRON_VERTICES[corners[2]];
+
+		// Resolve the global index of each grid point on the face
+		for (unsigned int i = 0; i <= frequency; i++) {
+			for (unsigned int j = 0; i + j <= frequency; j++) {
+
+				// Find which part of the icosahedron the grid point belongs to
+				unsigned int index;
+				unsigned int from, to, step;
+				if (i == 0 && j == 0) {
+					index = corners[0];
+				} else if (i == frequency) {
+					index = corners[1];
+				} else if (j == frequency) {
+					index = corners[2];
+				} else if (j == 0 || i == 0 || i + j == frequency) {
+
+					// Find the edge and the step from its starting corner
+					if (j == 0) {
+						from = corners[0], to = corners[1], step = i;
+					} else if (i == 0) {
+						from = corners[0], to = corners[2], step = j;
+					} else {
+						from = corners[1], to = corners[2], step = j;
+					}
+
+					// Edge interiors are numbered from the lower corner id
+					unsigned int edge = edgeIds[std::make_pair(std::min(from, to), std::max(from, to))];
+					unsigned int offset = from < to ? step : frequency - step;
+					index = edgeBase + edge * edgeStride + offset - 1;
+				} else {
+					index = faceBase + f * faceStride + rowStart[i] + j - 1;
+				}
+				grid[i * (frequency + 1) + j] = index;
+
+				// Interpolate the position on the flat face and project it on the sphere
+				double s = (double) i / frequency;
+				double t = (double) j / frequency;
+				double x = a[0] + s * (b[0] - a[0]) + t * (c[0] - a[0]);
+				double y = a[1] + s * (b[1] - a[1]) + t * (c[1] - a[1]);
+				double z = a[2] + s * (b[2] - a[2]) + t * (c[2] - a[2]);
+				double length = std::sqrt(x * x + y * y + z * z);
+				vertices[index] = Vertex((float) (x / length), (float) (y / length), (float) (z / length));
+			}
+		}
+
+		// Create the upward and downward triangles of the face grid
+		for (unsigned int i = 0; i < frequency; i++) {
+			for (unsigned int j = 0; i + j < frequency; j++) {
+				unsigned int p = grid[i * (frequency + 1) + j];
+				unsigned int q = grid[(i + 1) * (frequency + 1) + j];
+				unsigned int r = grid[i * (frequency + 1) + j + 1];
+				faces.push_back(Face(p, q, r));
+				if (i + j + 1 < frequency) {
+					unsigned int s = grid[(i + 1) * (frequency + 1) + j + 1];
+					faces.push_back(Face(q, s, r));
+				}
+			}
+		}
+	}
+
+	// Displace the vertices along the radius in order to get a noisy surface
+	if (noiseAmplitude > 0) {
+		std::mt19937 generator(seed);
+		std::uniform_real_distribution<double> distribution(-noiseAmplitude, noiseAmplitude);
+		for (size_t i = 0; i < vertices.size(); i++) {
+			vertices[i] *= (float) (1.0 + distribution(generator) / frequency);
+		}
+	}
+}
+
+void MeshGenerator::writeMesh(std::string filepath, const std::vector<Vertex> &vertices, const std::vector<Face> &faces) {
+
+	// Open the file in given location
+	std::ofstream outfile(filepath);
+
+	// Write the file format and the mesh information
+	outfile << "OFF" << "\n";
+	outfile << vertices.size() << " " << faces.size() << " " << faces.size() * 3 / 2 << "\n";
+
+	// Write the vertex coordinates with enough digits to keep the generated precision
+	outfile.precision(9);
+	for (size_t i = 0; i < vertices.size(); i++) {
+		outfile << vertices[i].x << " " << vertices[i].y << " " << vertices[i].z << "\n";
+	}
+
+	// Write the triangles
+	for (size_t i = 0; i < faces.size(); i++) {
+		outfile << "3 " << faces[i].a << " " << faces[i].b << " " << faces[i].c << "\n";
+	}
+
+	// Close the output file
+	outfile.close();
+}
+
+bool MeshGenerator::parseShape(const std::string &name, MeshShape &shape) {
+
+	// Look for the shape with the given name
+	const MeshShape shapes[] = { TORUS, ICOSPHERE, NOISY_SPHERE, WARPED_TORUS };
+	for (size_t i = 0; i < sizeof(shapes) / sizeof(shapes[0]); i++) {
+		if (name == getShapeName(shapes[i])) {
+			shape = shapes[i];
+			return true;
+		}
+	}
+
+	// Return false if the name does not match any shape
+	return false;
+}
+
+const char* MeshGenerator::getShapeName(MeshShape shape) {
+
+	// Return the command line name of the shape
+	switch (shape) {
+	case TORUS:
+		return "torus";
+	case ICOSPHERE:
+		return "icosphere";
+	case NOISY_SPHERE:
+		return "noisy-sphere";
+	case WARPED_TORUS:
+		return "warped-torus";
+	}
+	return "unknown";
+}
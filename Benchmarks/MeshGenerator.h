@@ -0,0 +1,39 @@
+#ifndef MESH_GENERATOR
+#define MESH_GENERATOR
+
+#include "Face.h"
+#include <vector>
+#include <string>
+#include <cstddef>
+
+enum MeshShape {
+	TORUS,
+	ICOSPHERE,
+	NOISY_SPHERE,
+	WARPED_TORUS
+};
+
+class MeshGenerator {
+public:
+
+	// Generates a closed triangular mesh of the given shape with approximately the given triangle count
+	static void generateMesh(MeshShape shape, size_t triangleCount, std::vector<Vertex> &vertices, std::vector<Face> &faces, unsigned int seed = 1);
+
+	// Generates a regular grid wrapped on a torus, optionally displaced by a sinusoidal warp along the tube
+	static void generateTorus(size_t triangleCount, double warpAmplitude, std::vector<Vertex> &vertices, std::vector<Face> &faces);
+
+	// Generates a subdivided icosahedron projected on a sphere, optionally with random radial noise
+	static void generateIcosphere(size_t triangleCount, double noiseAmplitude, unsigned int seed, std::vector<Vertex> &vertices, std::vector<Face> &faces);
+
+	// Writes a triangular mesh into an OFF file
+	static void writeMesh(std::string filepath, const std::vector<Vertex> &vertices, const std::vector<Face> &faces);
+
+	// Converts a shape name into the shape type, returns false if the name is unknown
+	static bool parseShape(const std::string &name, MeshShape &shape);
+
+	// Returns the name of the given shape
+	static const char* getShapeName(MeshShape shape);
+
+};
+
+#endif
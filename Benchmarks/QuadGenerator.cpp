@@ -0,0 +1,104 @@
+#include "QuadGenerator.h"
+#include <random>
+#include <cmath>
+
+#define PI 3.14159265358979323846
+
+void QuadGenerator::generateQuads(QuadSet set, size_t count, unsigned int seed, std::vector<Quadrilateral> &quads) {
+
+	// Create a deterministic random source for the set
+	std::mt19937 generator(seed);
+	std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+	std::uniform_real_distribution<float> scale(0.01f, 100.0f);
+
+	quads.clear();
+	quads.reserve(count);
+	for (size_t i = 0; i < count; i++) {
+
+		// Place the quadrilateral at a random position with a random size
+		const Vertex center(100 * unit(generator), 100 * unit(generator), 100 * unit(generator));
+		const float size = scale(generator);
+
+		// Start from a square with jittered corners on the z=0 plane
+		Vertex a(-1 + 0.3f * unit(generator), -1 + 0.3f * unit(generator), 0);
+		Vertex b(1 + 0.3f * unit(generator), -1 + 0.3f * unit(generator), 0);
+		Vertex c(1 + 0.3f * unit(generator), 1 + 0.3f * unit(generator), 0);
+		Vertex d(-1 + 0.3f * unit(generator), 1 + 0.3f * unit(generator), 0);
+
+		// Shape the quadrilateral depending on the set
+		switch (set) {
+		case RANDOM_QUADS:
+
+			// Lift the corners out of the plane to get warped quadrilaterals
+			a.z = 0.5f * unit(generator);
+			b.z = 0.5f * unit(generator);
+			c.z = 0.5f * unit(generator);
+			d.z = 0.5f * unit(generator);
+			break;
+
+		case PLANAR_QUADS:
+			break;
+
+		case CONCAVE_QUADS:
+
+			// Push one corner past the opposite diagonal to create a reflex angle
+			c = Vertex(-0.5f + 0.2f * unit(generator), -0.5f + 0.2f * unit(generator), 0.05f * unit(generator));
+			break;
+
+		case DEGENERATE_QUADS:
+
+			// Collapse a corner onto its neighbor or flatten the quadrilateral into a sliver
+			if (i % 2 == 0) {
+				b = a + Vertex(1e-6f * unit(generator), 1e-6f * unit(generator), 1e-6f * unit(generator));
+			} else {
+				a.y = b.y = c.y = d.y = 1e-5f * unit(generator);
+			}
+			break;
+		}
+
+		// Rotate the quadrilateral randomly around the z and x axes
+		const float alpha = (float) PI * unit(generator);
+		const float beta = (float) PI * unit(generator);
+		Vertex* corners[Quadrilateral::POINT_COUNT] = { &a, &b, &c, &d };
+		for (int k = 0; k < Quadrilateral::POINT_COUNT; k++) {
+			Vertex p = *corners[k];
+			Vertex q(p.x * std::cos(alpha) - p.y * std::sin(alpha), p.x * std::sin(alpha) + p.y * std::cos(alpha), p.z);
+			Vertex r(q.x, q.y * std::cos(beta) - q.z * std::sin(beta), q.y * std::sin(beta) + q.z * std::cos(beta));
+			*corners[k] = center + r * size;
+		}
+
+		// Store the quadrilateral
+		quads.push_back(Quadrilateral{a, b, c, d});
+	}
+}
+
+bool QuadGenerator::parseSet(const std::string &name, QuadSet &set) {
+
+	// Look for the set with the given name
+	const QuadSet sets[] = { RANDOM_QUADS, PLANAR_QUADS, CONCAVE_QUADS, DEGENERATE_QUADS };
+	for (size_t i = 0; i < sizeof(sets) / sizeof(sets[0]); i++) {
+		if (name == getSetName(sets[i])) {
+			set = sets[i];
+			return true;
+		}
+	}
+
+	// Return false if the name does not match any set
+	return false;
+}
+
+const char* QuadGenerator::getSetName(QuadSet set) {
+
+	// Return the command line name of the set
+	switch (set) {
+	case RANDOM_QUADS:
+		return "random";
+	case PLANAR_QUADS:
+		return "planar";
+	case CONCAVE_QUADS:
+		return "concave";
+	case DEGENERATE_QUADS:
+		return "degenerate";
+	}
+	return "unknown";
+}
@@ -0,0 +1,30 @@
+#ifndef QUAD_GENERATOR
+#define QUAD_GENERATOR
+
+#include "Quadrilateral.h"
+#include <vector>
+#include <string>
+#include <cstddef>
+
+enum QuadSet {
+	RANDOM_QUADS,
+	PLANAR_QUADS,
+	CONCAVE_QUADS,
+	DEGENERATE_QUADS
+};
+
+class QuadGenerator {
+public:
+
+	// Generates the given number of quadrilaterals from the given family
+	static void generateQuads(QuadSet set, size_t count, unsigned int seed, std::vector<Quadrilateral> &quads);
+
+	// Converts a set name into the set type, returns false if the name is unknown
+	static bool parseSet(const std::string &name, QuadSet &set);
+
+	// Returns the name of the given set
+	static const char* getSetName(QuadSet set);
+
+};
+
+#endif
@@ -0,0 +1,32 @@
+#ifndef TIMER
+#define TIMER
+
+#include <chrono>
+
+class Timer {
+public:
+
+	// Constructor, starts the timer
+	Timer() {
+		reset();
+	}
+
+	// Restarts the timer
+	void reset() {
+		startTime = std::chrono::steady_clock::now();
+	}
+
+	// Returns the wall-clock time passed since the last reset in seconds
+	double getElapsedSeconds() const {
+		std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+		return elapsed.count();
+	}
+
+private:
+
+	// Time point of the last reset
+	std::chrono::steady_clock::time_point startTime;
+
+};
+
+#endif
@@ -0,0 +1,34 @@
+#include "MeshReader.h"
+#include "MeshWriter.h"
+#include <iostream>
+#include <string>
+#include <vector>
+
+int main(int argc, char **argv) {
+
+	// Read the input and output file names from command line
+	if (argc != 3) {
+		std::cout << "Usage: MeshConverter <input.off> <output.wbm>" << std::endl;
+		std::cout << "Converts an OFF or binary mesh into the binary mesh format, polygons are split into triangles" << std::endl;
+		return 1;
+	}
+	std::string inputFile = argv[1];
+	std::string outputFile = argv[2];
+
+	// Read the vertex and face lists of the input mesh
+	std::vector<Vertex> vertexList;
+	std::vector<Face> faceList;
+	if (!MeshReader::getInstance()->readMeshData(inputFile, vertexList, faceList)) {
+		return 1;
+	}
+
+	// Write the lists into the binary mesh
+	if (!MeshWriter::getInstance()->writeBinaryMesh(outputFile, vertexList, faceList)) {
+		std::cerr << outputFile << ": cannot write file" << std::endl;
+		return 1;
+	}
+
+	// Output the converted mesh information
+	std::cout << "Converted " << vertexList.size() << " vertices and " << faceList.size() << " triangles" << std::endl;
+	return 0;
+}
@@ -0,0 +1,55 @@
+#ifndef ARRAY_VIEW
+#define ARRAY_VIEW
+
+#include <cstddef>
+
+// Read-only view of a contiguous array that is owned by someone else
+template <typename T>
+class ArrayView {
+public:
+
+	// Constructor of an empty view
+	ArrayView() {
+		first = 0;
+		count = 0;
+	}
+
+	// Constructor of a view on the given elements
+	ArrayView(const T* data, size_t size) {
+		first = data;
+		count = size;
+	}
+
+	const T* begin() const {
+		return first;
+	}
+
+	const T* end() const {
+		return first + count;
+	}
+
+	const T* data() const {
+		return first;
+	}
+
+	size_t size() const {
+		return count;
+	}
+
+	bool empty() const {
+		return count == 0;
+	}
+
+	const T& operator[](size_t index) const {
+		return first[index];
+	}
+
+private:
+
+	// First element and the number of elements
+	const T* first;
+	size_t count;
+
+};
+
+#endif
@@ -0,0 +1,188 @@
+#include "AugmentingPathRepair.h"
+#include "ParallelFunctions.h"
+#include <algorithm>
+#include <chrono>
+
+// Number of searches between two looks at the clock
+#define CLOCK_CHECK_INTERVAL 64
+
+AugmentingPathRepair::AugmentingPathRepair(const TriangularMesh* mesh, const EdgeMetricCache* metricCache, unsigned int hopLimit, double warpageCap) {
+	this->mesh = mesh;
+	this->metricCache = metricCache;
+	this->hopLimit = hopLimit;
+	this->warpageCap = warpageCap;
+	roundCount = 0;
+	searchCount = 0;
+	conflictCount = 0;
+	timedOut = false;
+}
+
+size_t AugmentingPathRepair::repair(std::vector<unsigned int> &partners, double timeBudget) {
+
+	// Find the moment the searches must stop
+	std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(timeBudget));
+
+	// Every unmatched face is searched in the first round
+	std::vector<unsigned int> startFaces;
+	for (size_t face = 0; face < partners.size(); face++) {
+		if (partners[face] == INVALID_INDEX) {
+			startFaces.push_back((unsigned int) face);
+		}
+	}
+
+	// Faces flipped in a round are marked with the round number
+	std::vector<size_t> roundMarks(partners.size(), 0);
+	size_t pairCount = 0;
+	unsigned int threadCount = ParallelFunctions::getThreadCount();
+	while (!startFaces.empty() && !timedOut) {
+		roundCount++;
+
+		// Search the paths on every thread on the same matching, the paths of a thread are stored one after another
+		std::vector<std::vector<unsigned int> > paths(threadCount);
+		std::vector<std::vector<size_t> > pathEnds(threadCount);
+		std::vector<std::vector<size_t> > pathStarts(threadCount);
+		std::vector<unsigned char> searchedFlags(startFaces.size(), 0);
+		ParallelFunctions::parallelFor(0, startFaces.size(), [&](size_t first, size_t last, unsigned int thread) {
+			std::vector<SearchNode> nodes;
+			std::vector<unsigned int> path;
+			for (size_t i = first; i < last; i++) {
+
+				// Stop searching once the time budget runs out
+				if ((i - first) % CLOCK_CHECK_INTERVAL == 0 && std::chrono::steady_clock::now() > deadline) {
+					break;
+				}
+				searchedFlags[i] = 1;
+				if (findPath(startFaces[i], partners, nodes, path)) {
+					paths[thread].insert(paths[thread].end(), path.begin(), path.end());
+					pathEnds[thread].push_back(paths[thread].size());
+					pathStarts[thread].push_back(i);
+				}
+			}
+		});
+
+		// Flip the paths in the order of their start faces while they share no face with a flipped path
+		std::vector<unsigned int> retryFaces;
+		for (unsigned int thread = 0; thread < threadCount; thread++) {
+			size_t pathBegin = 0;
+			for (size_t j = 0; j < pathEnds[thread].size(); j++) {
+				const unsigned int* path = paths[thread].data() + pathBegin;
+				size_t length = pathEnds[thread][j] - pathBegin;
+				pathBegin = pathEnds[thread][j];
+
+				// Retry the face in the next round if its path overlaps a flipped one
+				bool overlaps = false;
+				for (size_t k = 0; k < length && !overlaps; k++) {
+					overlaps = roundMarks[path[k]] == roundCount;
+				}
+				if (overlaps) {
+					conflictCount++;
+					retryFaces.push_back(startFaces[pathStarts[thread][j]]);
+					continue;
+				}
+
+				// Match the faces of the path in pairs
+				for (size_t k = 0; k < length; k += 2) {
+					partners[path[k]] = path[k + 1];
+					partners[path[k + 1]] = path[k];
+					roundMarks[path[k]] = roundCount;
+					roundMarks[path[k + 1]] = roundCount;
+				}
+				pairCount++;
+			}
+		}
+
+		// Count the searches and note whether the budget ran out
+		for (size_t i = 0; i < searchedFlags.size(); i++) {
+			searchCount += searchedFlags[i];
+			timedOut = timedOut || !searchedFlags[i];
+		}
+
+		// Faces that got matched as the end of another path need no retry
+		startFaces.clear();
+		for (size_t i = 0; i < retryFaces.size(); i++) {
+			if (partners[retryFaces[i]] == INVALID_INDEX) {
+				startFaces.push_back(retryFaces[i]);
+			}
+		}
+		timedOut = timedOut || (!startFaces.empty() && std::chrono::steady_clock::now() > deadline);
+	}
+
+	// Return the number of pairs added
+	return pairCount;
+}
+
+bool AugmentingPathRepair::findPath(unsigned int face, const std::vector<unsigned int> &partners, std::vector<SearchNode> &nodes, std::vector<unsigned int> &path) const {
+
+	// Search breadth first so the shortest path is found, the nodes are faces at an even distance from the start
+	nodes.clear();
+	nodes.push_back({face, INVALID_INDEX, INVALID_INDEX, 0});
+	for (unsigned int i = 0; i < nodes.size(); i++) {
+		SearchNode node = nodes[i];
+
+		// The nodes are in order of length, so no later node has room for another edge either
+		if (node.length + 1 > hopLimit) {
+			break;
+		}
+		for (unsigned int halfEdge = node.face * 3; halfEdge < node.face * 3 + 3; halfEdge++) {
+
+			// Skip boundaries, the matched edge and edges above the warpage cap, the comparison also rejects NaN
+			unsigned int twin = mesh->getTwin(halfEdge);
+			if (twin == INVALID_INDEX) {
+				continue;
+			}
+			unsigned int neighbor = twin / 3;
+			if (neighbor == node.matchedFace || !(metricCache->getStoredMaximumWarpage(halfEdge) <= warpageCap)) {
+				continue;
+			}
+
+			// Keep the path simple, a face may be reached only once
+			bool visited = false;
+			for (size_t j = 0; j < nodes.size() && !visited; j++) {
+				visited = nodes[j].face == neighbor || nodes[j].matchedFace == neighbor;
+			}
+			if (visited) {
+				continue;
+			}
+
+			// An unmatched neighbor ends the path, list its faces from the end back to the start
+			unsigned int partner = partners[neighbor];
+			if (partner == INVALID_INDEX) {
+				path.clear();
+				path.push_back(neighbor);
+				for (unsigned int j = i; j != INVALID_INDEX; j = nodes[j].parent) {
+					path.push_back(nodes[j].face);
+					if (nodes[j].matchedFace != INVALID_INDEX) {
+						path.push_back(nodes[j].matchedFace);
+					}
+				}
+				return true;
+			}
+
+			// Continue through the matched neighbor of the neighbor if a further edge fits under the hop limit
+			bool partnerVisited = false;
+			for (size_t j = 0; j < nodes.size() && !partnerVisited; j++) {
+				partnerVisited = nodes[j].face == partner || nodes[j].matchedFace == partner;
+			}
+			if (!partnerVisited && node.length + 3 <= hopLimit) {
+				nodes.push_back({partner, neighbor, i, node.length + 2});
+			}
+		}
+	}
+	return false;
+}
+
+size_t AugmentingPathRepair::getRoundCount() const {
+	return roundCount;
+}
+
+size_t AugmentingPathRepair::getSearchCount() const {
+	return searchCount;
+}
+
+size_t AugmentingPathRepair::getConflictCount() const {
+	return conflictCount;
+}
+
+bool AugmentingPathRepair::isTimedOut() const {
+	return timedOut;
+}
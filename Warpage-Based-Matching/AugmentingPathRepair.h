@@ -0,0 +1,59 @@
+#ifndef AUGMENTING_PATH_REPAIR
+#define AUGMENTING_PATH_REPAIR
+
+#include "TriangularMesh.h"
+#include "EdgeMetricCache.h"
+#include <vector>
+
+// Post-pass that pairs unmatched faces along short augmenting paths of the face adjacency graph
+// A path starts and ends at unmatched faces and alternates between new edges and matched edges, flipping it adds one pair
+// Every round searches from all unmatched faces in parallel on the same matching and flips the paths that share no face
+class AugmentingPathRepair {
+public:
+
+	// Constructor, paths have at most the given number of edges and every new pair has at most the given warpage
+	AugmentingPathRepair(const TriangularMesh* mesh, const EdgeMetricCache* metricCache, unsigned int hopLimit, double warpageCap);
+
+	// Flips augmenting paths until none is found or the time budget in seconds runs out, returns the number of pairs added
+	// The partners hold the matched neighbor of every face and INVALID_INDEX for the unmatched faces
+	size_t repair(std::vector<unsigned int> &partners, double timeBudget);
+
+	// Number of rounds, path searches and found paths that overlapped a path flipped earlier in the same round
+	size_t getRoundCount() const;
+	size_t getSearchCount() const;
+	size_t getConflictCount() const;
+
+	// Returns true if the time budget ran out before every search was done
+	bool isTimedOut() const;
+
+private:
+
+	// Face reached on a path, the face before it is its matched neighbor and the node before that is the parent
+	struct SearchNode {
+		unsigned int face;
+		unsigned int matchedFace;
+		unsigned int parent;
+		unsigned int length;
+	};
+
+	// The mesh instance
+	const TriangularMesh* mesh;
+
+	// Metric values of the candidate quadrilaterals on the edges
+	const EdgeMetricCache* metricCache;
+
+	// Limits of the paths
+	unsigned int hopLimit;
+	double warpageCap;
+
+	size_t roundCount;
+	size_t searchCount;
+	size_t conflictCount;
+	bool timedOut;
+
+	// Searches a shortest augmenting path from the unmatched face, the path lists the faces in pairs to be matched
+	bool findPath(unsigned int face, const std::vector<unsigned int> &partners, std::vector<SearchNode> &nodes, std::vector<unsigned int> &path) const;
+
+};
+
+#endif
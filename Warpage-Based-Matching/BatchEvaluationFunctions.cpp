@@ -0,0 +1,151 @@
+#include "BatchEvaluationFunctions.h"
+
+#if defined(BATCH_KERNELS_X86) && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+InstructionSet BatchEvaluationFunctions::supportedInstructionSet = BatchEvaluationFunctions::detectInstructionSet();
+InstructionSet BatchEvaluationFunctions::instructionSet = BatchEvaluationFunctions::supportedInstructionSet;
+const BatchKernelTable* BatchEvaluationFunctions::kernels = BatchEvaluationFunctions::getKernels(BatchEvaluationFunctions::supportedInstructionSet);
+
+void BatchEvaluationFunctions::calculateMaximumWarpage(const QuadBatch &batch, float* results) {
+	kernels->calculateMaximumWarpage(batch, results);
+}
+
+void BatchEvaluationFunctions::calculateMinimumScaledJacobian(const QuadBatch &batch, float* results) {
+	kernels->calculateMinimumScaledJacobian(batch, results);
+}
+
+void BatchEvaluationFunctions::calculateDistortion(const QuadBatch &batch, float* results) {
+	kernels->calculateDistortion(batch, results);
+}
+
+void BatchEvaluationFunctions::calculateDistortion2(const QuadBatch &batch, float* results) {
+	kernels->calculateDistortion2(batch, results);
+}
+
+void BatchEvaluationFunctions::calculateAspectRatio(const QuadBatch &batch, float* results) {
+	kernels->calculateAspectRatio(batch, results);
+}
+
+InstructionSet BatchEvaluationFunctions::getInstructionSet() {
+	return instructionSet;
+}
+
+bool BatchEvaluationFunctions::setInstructionSet(InstructionSet instructionSet) {
+
+	// The kernels cannot run on a processor without the instructions
+	if (!isSupported(instructionSet)) {
+		return false;
+	}
+
+	// Switch to the kernels of the instruction set
+	BatchEvaluationFunctions::instructionSet = instructionSet;
+	kernels = getKernels(instructionSet);
+	return true;
+}
+
+bool BatchEvaluationFunctions::isSupported(InstructionSet instructionSet) {
+
+	// Every instruction set includes the ones before it
+	return instructionSet <= supportedInstructionSet;
+}
+
+bool BatchEvaluationFunctions::parseInstructionSet(const std::string &name, InstructionSet &instructionSet) {
+
+	// Compare the name with the name of each instruction set
+	const InstructionSet instructionSets[] = { GENERIC_INSTRUCTIONS, SSE42_INSTRUCTIONS, AVX2_INSTRUCTIONS, AVX512_INSTRUCTIONS };
+	for (size_t i = 0; i < sizeof(instructionSets) / sizeof(instructionSets[0]); i++) {
+		if (name == getInstructionSetName(instructionSets[i])) {
+			instructionSet = instructionSets[i];
+			return true;
+		}
+	}
+
+	// Unknown instruction set name
+	return false;
+}
+
+const char* BatchEvaluationFunctions::getInstructionSetName(InstructionSet instructionSet) {
+
+	// Return the command line name of the instruction set
+	switch (instructionSet) {
+	case GENERIC_INSTRUCTIONS:
+		return "generic";
+	case SSE42_INSTRUCTIONS:
+		return "sse4.2";
+	case AVX2_INSTRUCTIONS:
+		return "avx2";
+	case AVX512_INSTRUCTIONS:
+		return "avx512";
+	}
+	return "unknown";
+}
+
+InstructionSet BatchEvaluationFunctions::detectInstructionSet() {
+
+#if defined(BATCH_KERNELS_X86) && (defined(__GNUC__) || defined(__clang__))
+
+	// The compiler runtime checks both the processor and the register state saved by the operating system
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx512f")) {
+		return AVX512_INSTRUCTIONS;
+	}
+	if (__builtin_cpu_supports("avx2")) {
+		return AVX2_INSTRUCTIONS;
+	}
+	if (__builtin_cpu_supports("sse4.2")) {
+		return SSE42_INSTRUCTIONS;
+	}
+
+#elif defined(BATCH_KERNELS_X86) && defined(_MSC_VER)
+
+	// Read the feature flags of the processor
+	int info[4];
+	__cpuid(info, 0);
+	int leafCount = info[0];
+	__cpuid(info, 1);
+	bool sse42 = (info[2] & (1 << 20)) != 0;
+	bool osxsave = (info[2] & (1 << 27)) != 0;
+	int extendedFeatures = 0;
+	if (leafCount >= 7) {
+		__cpuidex(info, 7, 0);
+		extendedFeatures = info[1];
+	}
+
+	// The operating system has to save the vector registers on context switches
+	unsigned long long registerState = osxsave ? _xgetbv(0) : 0;
+	bool avxState = (registerState & 0x06) == 0x06;
+	bool avx512State = (registerState & 0xE6) == 0xE6;
+	if (avx512State && (extendedFeatures & (1 << 16)) != 0) {
+		return AVX512_INSTRUCTIONS;
+	}
+	if (avxState && (extendedFeatures & (1 << 5)) != 0) {
+		return AVX2_INSTRUCTIONS;
+	}
+	if (sse42) {
+		return SSE42_INSTRUCTIONS;
+	}
+
+#endif
+
+	// Fall back to the plain kernels
+	return GENERIC_INSTRUCTIONS;
+}
+
+const BatchKernelTable* BatchEvaluationFunctions::getKernels(InstructionSet instructionSet) {
+
+	// Return the table of the instruction set
+	switch (instructionSet) {
+#ifdef BATCH_KERNELS_X86
+	case SSE42_INSTRUCTIONS:
+		return &BatchKernels::getSse42Kernels();
+	case AVX2_INSTRUCTIONS:
+		return &BatchKernels::getAvx2Kernels();
+	case AVX512_INSTRUCTIONS:
+		return &BatchKernels::getAvx512Kernels();
+#endif
+	default:
+		return &BatchKernels::getGenericKernels();
+	}
+}
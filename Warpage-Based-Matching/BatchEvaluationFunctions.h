@@ -0,0 +1,60 @@
+#ifndef BATCH_EVALUATION_FUNCTIONS
+#define BATCH_EVALUATION_FUNCTIONS
+
+#include "QuadBatch.h"
+#include "BatchKernels.h"
+#include <string>
+
+enum InstructionSet {
+	GENERIC_INSTRUCTIONS,
+	SSE42_INSTRUCTIONS,
+	AVX2_INSTRUCTIONS,
+	AVX512_INSTRUCTIONS
+};
+
+// Evaluates the quality metrics of EvaluationFunctions on whole batches of quadrilaterals in single precision
+// The kernels of the best instruction set that the processor supports are selected at startup
+// The results follow the scalar functions within single precision, the arc cosine is a polynomial approximation
+class BatchEvaluationFunctions {
+public:
+
+	// Calculates the metric of every quadrilateral in the batch, the results hold one value per quadrilateral
+	static void calculateMaximumWarpage(const QuadBatch &batch, float* results);
+	static void calculateMinimumScaledJacobian(const QuadBatch &batch, float* results);
+	static void calculateDistortion(const QuadBatch &batch, float* results);
+	static void calculateDistortion2(const QuadBatch &batch, float* results);
+	static void calculateAspectRatio(const QuadBatch &batch, float* results);
+
+	// Returns the instruction set of the kernels in use
+	static InstructionSet getInstructionSet();
+
+	// Selects the kernels of the instruction set, returns false if the processor does not support it
+	static bool setInstructionSet(InstructionSet instructionSet);
+
+	// Checks whether the processor supports the instruction set
+	static bool isSupported(InstructionSet instructionSet);
+
+	// Finds the instruction set with the given name, returns false if there is no such instruction set
+	static bool parseInstructionSet(const std::string &name, InstructionSet &instructionSet);
+
+	// Returns the name of the instruction set
+	static const char* getInstructionSetName(InstructionSet instructionSet);
+
+private:
+
+	// Best instruction set of the processor and the one in use
+	static InstructionSet supportedInstructionSet;
+	static InstructionSet instructionSet;
+
+	// Kernels of the instruction set in use
+	static const BatchKernelTable* kernels;
+
+	// Finds the best instruction set that the processor and the operating system support
+	static InstructionSet detectInstructionSet();
+
+	// Returns the kernels of the instruction set
+	static const BatchKernelTable* getKernels(InstructionSet instructionSet);
+
+};
+
+#endif
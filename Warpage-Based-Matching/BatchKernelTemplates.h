@@ -0,0 +1,322 @@
+#ifndef BATCH_KERNEL_TEMPLATES
+#define BATCH_KERNEL_TEMPLATES
+
+#include "BatchKernels.h"
+#include <cstddef>
+
+// The metric kernels written once for any lane type V, every instruction set file instantiates them with its own V
+// V holds WIDTH floats and provides V(float), load, store, the arithmetic operators, sqrt, abs, minimum, greater and select
+// minimum(a, b) returns b when either of them is NaN like the vector instructions do
+// Only the lane types differ between the files, so no instantiation is shared between files compiled with different flags
+
+// Three coordinates of as many vectors as V has lanes
+template <typename V>
+struct VectorLanes {
+	V x;
+	V y;
+	V z;
+};
+
+// Corners of as many quadrilaterals as V has lanes
+template <typename V>
+struct QuadLanes {
+	VectorLanes<V> a;
+	VectorLanes<V> b;
+	VectorLanes<V> c;
+	VectorLanes<V> d;
+};
+
+template <typename V>
+class BatchMetricFunctions {
+public:
+
+	// Returns the kernels of every metric on the lane type
+	static const BatchKernelTable createKernelTable() {
+		BatchKernelTable table;
+		table.calculateMaximumWarpage = evaluateBatch<calculateMaximumWarpage>;
+		table.calculateMinimumScaledJacobian = evaluateBatch<calculateMinimumScaledJacobian>;
+		table.calculateDistortion = evaluateBatch<calculateDistortion>;
+		table.calculateDistortion2 = evaluateBatch<calculateDistortion2>;
+		table.calculateAspectRatio = evaluateBatch<calculateAspectRatio>;
+		return table;
+	}
+
+private:
+
+	// Runs the metric on every quadrilateral of the batch
+	template <V (*metric)(const QuadLanes<V> &quads)>
+	static void evaluateBatch(const QuadBatch &batch, float* results) {
+
+		// Evaluate the full vectors straight into the results
+		size_t size = batch.getSize();
+		size_t index = 0;
+		for (; index + V::WIDTH <= size; index += V::WIDTH) {
+			metric(loadQuads(batch, index)).store(results + index);
+		}
+
+		// The last vector reads the zero padding of the batch, only its valid lanes are copied out
+		if (index < size) {
+			float tail[V::WIDTH];
+			metric(loadQuads(batch, index)).store(tail);
+			for (size_t i = 0; index + i < size; i++) {
+				results[index + i] = tail[i];
+			}
+		}
+	}
+
+	// Loads the corners of the quadrilaterals starting at the index
+	static QuadLanes<V> loadQuads(const QuadBatch &batch, size_t index) {
+		QuadLanes<V> quads;
+		quads.a.x = V::load(batch.ax + index); quads.a.y = V::load(batch.ay + index); quads.a.z = V::load(batch.az + index);
+		quads.b.x = V::load(batch.bx + index); quads.b.y = V::load(batch.by + index); quads.b.z = V::load(batch.bz + index);
+		quads.c.x = V::load(batch.cx + index); quads.c.y = V::load(batch.cy + index); quads.c.z = V::load(batch.cz + index);
+		quads.d.x = V::load(batch.dx + index); quads.d.y = V::load(batch.dy + index); quads.d.z = V::load(batch.dz + index);
+		return quads;
+	}
+
+	// Maximum of the warpage on the two diagonals, see EvaluationFunctions::calculateMaximumWarpage
+	static V calculateMaximumWarpage(const QuadLanes<V> &quads) {
+
+		// Get the edges of the quadrilaterals
+		const VectorLanes<V> AB = subtract(quads.b, quads.a);
+		const VectorLanes<V> AD = subtract(quads.d, quads.a);
+		const VectorLanes<V> CB = subtract(quads.b, quads.c);
+		const VectorLanes<V> CD = subtract(quads.d, quads.c);
+
+		// Calculate the angle between the normals of the triangles for the horizontal diagonal
+		V horizontalWarpage = calculateNormalAngle(cross(AB, AD), cross(CD, CB));
+
+		// Calculate the angle between the normals of the triangles for the vertical diagonal
+		const VectorLanes<V> BA = subtract(quads.a, quads.b);
+		const VectorLanes<V> BC = subtract(quads.c, quads.b);
+		const VectorLanes<V> DA = subtract(quads.a, quads.d);
+		const VectorLanes<V> DC = subtract(quads.c, quads.d);
+		V verticalWarpage = calculateNormalAngle(cross(BC, BA), cross(DA, DC));
+
+		// Return the horizontal warpage amount if it is greater, the vertical one elsewhere
+		return select(greater(horizontalWarpage, verticalWarpage), horizontalWarpage, verticalWarpage);
+	}
+
+	// Minimum sine of the corner angles, see EvaluationFunctions::calculateMinimumScaledJacobian
+	static V calculateMinimumScaledJacobian(const QuadLanes<V> &quads) {
+
+		// Get the edges around the corners
+		const VectorLanes<V> AB = subtract(quads.b, quads.a);
+		const VectorLanes<V> BC = subtract(quads.c, quads.b);
+		const VectorLanes<V> CD = subtract(quads.d, quads.c);
+		const VectorLanes<V> DA = subtract(quads.a, quads.d);
+
+		// The projected corner triangles give the sine of the angle between the edges of the corner
+		V jacobianA = calculateSine(AB, DA);
+		V jacobianB = calculateSine(BC, AB);
+		V jacobianC = calculateSine(CD, BC);
+		V jacobianD = calculateSine(DA, CD);
+
+		// Return the minimum scaled jacobian value
+		return minimum(minimum(jacobianA, jacobianB), minimum(jacobianC, jacobianD));
+	}
+
+	// Distortion of the triangles on the diagonal intersection, see EvaluationFunctions::calculateDistortion
+	static V calculateDistortion(const QuadLanes<V> &quads) {
+
+		// Find the intersection point of the diagonals in the z=0 plane
+		V a1 = quads.c.y - quads.a.y;
+		V b1 = quads.a.x - quads.c.x;
+		V c1 = a1 * quads.a.x + b1 * quads.a.y;
+		V a2 = quads.d.y - quads.b.y;
+		V b2 = quads.b.x - quads.d.x;
+		V c2 = a2 * quads.b.x + b2 * quads.b.y;
+		V determinant = a1 * b2 - a2 * b1;
+		VectorLanes<V> intersection;
+		intersection.x = (b2 * c1 - b1 * c2) / determinant;
+		intersection.y = (a1 * c2 - a2 * c1) / determinant;
+		intersection.z = V(0.0f);
+
+		// Calculate the distortion of the four triangles created by the diagonals
+		V alphaAB = calculateTriangleDistortion(quads.a, quads.b, intersection);
+		V alphaBC = calculateTriangleDistortion(quads.b, quads.c, intersection);
+		V alphaCD = calculateTriangleDistortion(quads.c, quads.d, intersection);
+		V alphaDA = calculateTriangleDistortion(quads.d, quads.a, intersection);
+
+		// Sort the distortion amounts in descending order with a sorting network
+		V high1 = maximum(alphaAB, alphaBC);
+		V low1 = minimum(alphaAB, alphaBC);
+		V high2 = maximum(alphaCD, alphaDA);
+		V low2 = minimum(alphaCD, alphaDA);
+		V first = maximum(high1, high2);
+		V middle1 = minimum(high1, high2);
+		V middle2 = maximum(low1, low2);
+		V fourth = minimum(low1, low2);
+		V second = maximum(middle1, middle2);
+		V third = minimum(middle1, middle2);
+
+		// Calculate and return the quadrilateral distortion
+		return (third * fourth) / (first * second);
+	}
+
+	// Corner cross products over squared edge lengths, see EvaluationFunctions::calculateDistortion2
+	static V calculateDistortion2(const QuadLanes<V> &quads) {
+
+		// Get the edges around the corners
+		const VectorLanes<V> AB = subtract(quads.b, quads.a);
+		const VectorLanes<V> AD = subtract(quads.d, quads.a);
+		const VectorLanes<V> BC = subtract(quads.c, quads.b);
+		const VectorLanes<V> BA = subtract(quads.a, quads.b);
+		const VectorLanes<V> CD = subtract(quads.d, quads.c);
+		const VectorLanes<V> CB = subtract(quads.b, quads.c);
+		const VectorLanes<V> DA = subtract(quads.a, quads.d);
+		const VectorLanes<V> DC = subtract(quads.c, quads.d);
+
+		// Calculate the nominator and denominator, every edge appears twice in the square lengths
+		V nominator = abs(sumCross(AB, AD)) + abs(sumCross(BC, BA)) + abs(sumCross(CD, CB)) + abs(sumCross(DA, DC));
+		V denominator = V(2.0f) * (dot(AB, AB) + dot(BC, BC) + dot(CD, CD) + dot(DA, DA));
+
+		// Return the distortion value
+		return V(2.0f) * sqrt(sqrt(nominator / denominator));
+	}
+
+	// Ratio of the lines through the edge middle points, see EvaluationFunctions::calculateAspectRatio
+	static V calculateAspectRatio(const QuadLanes<V> &quads) {
+
+		// Calculate the average of the corner points
+		VectorLanes<V> origin;
+		origin.x = (quads.a.x + quads.b.x + quads.c.x + quads.d.x) * V(0.25f);
+		origin.y = (quads.a.y + quads.b.y + quads.c.y + quads.d.y) * V(0.25f);
+		origin.z = (quads.a.z + quads.b.z + quads.c.z + quads.d.z) * V(0.25f);
+
+		// Calculate the average of the corner normals
+		const VectorLanes<V> AB = subtract(quads.b, quads.a);
+		const VectorLanes<V> BC = subtract(quads.c, quads.b);
+		const VectorLanes<V> CD = subtract(quads.d, quads.c);
+		const VectorLanes<V> DA = subtract(quads.a, quads.d);
+		const VectorLanes<V> normalA = cross(AB, negate(DA));
+		const VectorLanes<V> normalB = cross(BC, negate(AB));
+		const VectorLanes<V> normalC = cross(CD, negate(BC));
+		const VectorLanes<V> normalD = cross(DA, negate(CD));
+		VectorLanes<V> normal;
+		normal.x = (normalA.x + normalB.x + normalC.x + normalD.x) * V(0.25f);
+		normal.y = (normalA.y + normalB.y + normalC.y + normalD.y) * V(0.25f);
+		normal.z = (normalA.z + normalB.z + normalC.z + normalD.z) * V(0.25f);
+
+		// Normalize the absolute components of the average normal like the scalar function does
+		V length = sqrt(dot(normal, normal));
+		normal.x = abs(normal.x) / length;
+		normal.y = abs(normal.y) / length;
+		normal.z = abs(normal.z) / length;
+
+		// Project the corners onto the plane through the origin
+		const VectorLanes<V> projectedA = project(quads.a, origin, normal);
+		const VectorLanes<V> projectedB = project(quads.b, origin, normal);
+		const VectorLanes<V> projectedC = project(quads.c, origin, normal);
+		const VectorLanes<V> projectedD = project(quads.d, origin, normal);
+
+		// Find the lines passing through the middle points of the opposite edges, the halves cancel out in the ratio
+		const VectorLanes<V> vertical = subtract(add(projectedC, projectedD), add(projectedA, projectedB));
+		const VectorLanes<V> horizontal = subtract(add(projectedD, projectedA), add(projectedB, projectedC));
+		V verticalLength = sqrt(dot(vertical, vertical));
+		V horizontalLength = sqrt(dot(horizontal, horizontal));
+
+		// Divide the longer line by the shorter one
+		return select(greater(verticalLength, horizontalLength), verticalLength / horizontalLength, horizontalLength / verticalLength);
+	}
+
+	// Angle in degrees between two normals of any length, NaN if either of them is zero
+	static V calculateNormalAngle(const VectorLanes<V> &a, const VectorLanes<V> &b) {
+
+		// Find the chord between the unit normals
+		V lengthA = sqrt(dot(a, a));
+		V lengthB = sqrt(dot(b, b));
+		VectorLanes<V> chord;
+		chord.x = a.x / lengthA - b.x / lengthB;
+		chord.y = a.y / lengthA - b.y / lengthB;
+		chord.z = a.z / lengthA - b.z / lengthB;
+
+		// The angle is twice the arc sine of the half chord, which stays accurate for nearly parallel normals
+		V halfChord = minimum(V(1.0f), sqrt(dot(chord, chord)) * V(0.5f));
+		V angle = V(3.14159265f) - V(2.0f) * approximateAcos(halfChord);
+		return angle * V(57.2957795f);
+	}
+
+	// Arc cosine of x in [0, 1], Abramowitz and Stegun 4.4.46 with an error below 2e-8
+	static V approximateAcos(V x) {
+		V polynomial = V(-0.0012624911f);
+		polynomial = polynomial * x + V(0.0066700901f);
+		polynomial = polynomial * x + V(-0.0170881256f);
+		polynomial = polynomial * x + V(0.0308918810f);
+		polynomial = polynomial * x + V(-0.0501743046f);
+		polynomial = polynomial * x + V(0.0889789874f);
+		polynomial = polynomial * x + V(-0.2145988016f);
+		polynomial = polynomial * x + V(1.5707963050f);
+		return sqrt(V(1.0f) - x) * polynomial;
+	}
+
+	// Sine of the angle between the two edges
+	static V calculateSine(const VectorLanes<V> &a, const VectorLanes<V> &b) {
+		const VectorLanes<V> product = cross(a, b);
+		return sqrt(dot(product, product)) / sqrt(dot(a, a) * dot(b, b));
+	}
+
+	// Distortion of a triangle defined by Lee & Lo, see EvaluationFunctions::calculateTriangleDistortion
+	static V calculateTriangleDistortion(const VectorLanes<V> &a, const VectorLanes<V> &b, const VectorLanes<V> &c) {
+		const VectorLanes<V> CA = subtract(a, c);
+		const VectorLanes<V> CB = subtract(b, c);
+		const VectorLanes<V> AB = subtract(b, a);
+		V squareSum = dot(CA, CA) + dot(AB, AB) + dot(CB, CB);
+		return V(3.46410162f) * sumCross(CA, CB) / squareSum;
+	}
+
+	// Moves the point relative to the origin and removes its distance along the normal
+	static VectorLanes<V> project(const VectorLanes<V> &point, const VectorLanes<V> &origin, const VectorLanes<V> &normal) {
+		const VectorLanes<V> relative = subtract(point, origin);
+		V distance = dot(normal, relative);
+		VectorLanes<V> projection;
+		projection.x = relative.x - distance * normal.x;
+		projection.y = relative.y - distance * normal.y;
+		projection.z = relative.z - distance * normal.z;
+		return projection;
+	}
+
+	static VectorLanes<V> add(const VectorLanes<V> &a, const VectorLanes<V> &b) {
+		VectorLanes<V> result;
+		result.x = a.x + b.x;
+		result.y = a.y + b.y;
+		result.z = a.z + b.z;
+		return result;
+	}
+
+	static VectorLanes<V> subtract(const VectorLanes<V> &a, const VectorLanes<V> &b) {
+		VectorLanes<V> result;
+		result.x = a.x - b.x;
+		result.y = a.y - b.y;
+		result.z = a.z - b.z;
+		return result;
+	}
+
+	static VectorLanes<V> negate(const VectorLanes<V> &a) {
+		VectorLanes<V> result;
+		result.x = V(0.0f) - a.x;
+		result.y = V(0.0f) - a.y;
+		result.z = V(0.0f) - a.z;
+		return result;
+	}
+
+	static VectorLanes<V> cross(const VectorLanes<V> &a, const VectorLanes<V> &b) {
+		VectorLanes<V> result;
+		result.x = a.y * b.z - a.z * b.y;
+		result.y = a.z * b.x - a.x * b.z;
+		result.z = a.x * b.y - a.y * b.x;
+		return result;
+	}
+
+	static V dot(const VectorLanes<V> &a, const VectorLanes<V> &b) {
+		return a.x * b.x + a.y * b.y + a.z * b.z;
+	}
+
+	// Sum of the cross product components, see GeometricFunctions::crossProduct
+	static V sumCross(const VectorLanes<V> &a, const VectorLanes<V> &b) {
+		return (a.y * b.z - a.z * b.y) + (a.z * b.x - a.x * b.z) + (a.x * b.y - a.y * b.x);
+	}
+
+};
+
+#endif
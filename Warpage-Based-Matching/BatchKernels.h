@@ -0,0 +1,37 @@
+#ifndef BATCH_KERNELS
+#define BATCH_KERNELS
+
+#include "QuadBatch.h"
+
+// The vector kernels are only compiled on x86 targets
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define BATCH_KERNELS_X86
+#endif
+
+// Evaluates a metric for every quadrilateral of the batch into the results
+typedef void (*BatchKernel)(const QuadBatch &batch, float* results);
+
+// Metric kernels compiled for one instruction set
+struct BatchKernelTable {
+	BatchKernel calculateMaximumWarpage;
+	BatchKernel calculateMinimumScaledJacobian;
+	BatchKernel calculateDistortion;
+	BatchKernel calculateDistortion2;
+	BatchKernel calculateAspectRatio;
+};
+
+// Kernel tables of the instruction sets, every table lives in its own file compiled with the flags of its instruction set
+class BatchKernels {
+public:
+
+	static const BatchKernelTable& getGenericKernels();
+
+#ifdef BATCH_KERNELS_X86
+	static const BatchKernelTable& getSse42Kernels();
+	static const BatchKernelTable& getAvx2Kernels();
+	static const BatchKernelTable& getAvx512Kernels();
+#endif
+
+};
+
+#endif
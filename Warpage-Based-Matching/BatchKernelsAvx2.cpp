@@ -0,0 +1,42 @@
+#include "BatchKernelTemplates.h"
+
+#ifdef BATCH_KERNELS_X86
+
+#include <immintrin.h>
+
+// Eight quadrilaterals at a time in AVX registers
+struct Avx2Lanes {
+
+	const static size_t WIDTH = 8;
+
+	typedef __m256 Mask;
+
+	__m256 value;
+
+	Avx2Lanes() {}
+	Avx2Lanes(float value) : value(_mm256_set1_ps(value)) {}
+	Avx2Lanes(__m256 value) : value(value) {}
+
+	static Avx2Lanes load(const float* data) { return _mm256_loadu_ps(data); }
+	void store(float* data) const { _mm256_storeu_ps(data, value); }
+
+	friend Avx2Lanes operator+(Avx2Lanes a, Avx2Lanes b) { return _mm256_add_ps(a.value, b.value); }
+	friend Avx2Lanes operator-(Avx2Lanes a, Avx2Lanes b) { return _mm256_sub_ps(a.value, b.value); }
+	friend Avx2Lanes operator*(Avx2Lanes a, Avx2Lanes b) { return _mm256_mul_ps(a.value, b.value); }
+	friend Avx2Lanes operator/(Avx2Lanes a, Avx2Lanes b) { return _mm256_div_ps(a.value, b.value); }
+
+	friend Avx2Lanes sqrt(Avx2Lanes a) { return _mm256_sqrt_ps(a.value); }
+	friend Avx2Lanes abs(Avx2Lanes a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.value); }
+	friend Avx2Lanes minimum(Avx2Lanes a, Avx2Lanes b) { return _mm256_min_ps(a.value, b.value); }
+	friend Avx2Lanes maximum(Avx2Lanes a, Avx2Lanes b) { return _mm256_max_ps(a.value, b.value); }
+	friend Mask greater(Avx2Lanes a, Avx2Lanes b) { return _mm256_cmp_ps(a.value, b.value, _CMP_GT_OQ); }
+	friend Avx2Lanes select(Mask mask, Avx2Lanes a, Avx2Lanes b) { return _mm256_blendv_ps(b.value, a.value, mask); }
+
+};
+
+const BatchKernelTable& BatchKernels::getAvx2Kernels() {
+	static const BatchKernelTable table = BatchMetricFunctions<Avx2Lanes>::createKernelTable();
+	return table;
+}
+
+#endif
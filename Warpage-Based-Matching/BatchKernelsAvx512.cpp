@@ -0,0 +1,42 @@
+#include "BatchKernelTemplates.h"
+
+#ifdef BATCH_KERNELS_X86
+
+#include <immintrin.h>
+
+// Sixteen quadrilaterals at a time in AVX-512 registers, only the foundation instructions are used
+struct Avx512Lanes {
+
+	const static size_t WIDTH = 16;
+
+	typedef __mmask16 Mask;
+
+	__m512 value;
+
+	Avx512Lanes() {}
+	Avx512Lanes(float value) : value(_mm512_set1_ps(value)) {}
+	Avx512Lanes(__m512 value) : value(value) {}
+
+	static Avx512Lanes load(const float* data) { return _mm512_loadu_ps(data); }
+	void store(float* data) const { _mm512_storeu_ps(data, value); }
+
+	friend Avx512Lanes operator+(Avx512Lanes a, Avx512Lanes b) { return _mm512_add_ps(a.value, b.value); }
+	friend Avx512Lanes operator-(Avx512Lanes a, Avx512Lanes b) { return _mm512_sub_ps(a.value, b.value); }
+	friend Avx512Lanes operator*(Avx512Lanes a, Avx512Lanes b) { return _mm512_mul_ps(a.value, b.value); }
+	friend Avx512Lanes operator/(Avx512Lanes a, Avx512Lanes b) { return _mm512_div_ps(a.value, b.value); }
+
+	friend Avx512Lanes sqrt(Avx512Lanes a) { return _mm512_sqrt_ps(a.value); }
+	friend Avx512Lanes abs(Avx512Lanes a) { return _mm512_abs_ps(a.value); }
+	friend Avx512Lanes minimum(Avx512Lanes a, Avx512Lanes b) { return _mm512_min_ps(a.value, b.value); }
+	friend Avx512Lanes maximum(Avx512Lanes a, Avx512Lanes b) { return _mm512_max_ps(a.value, b.value); }
+	friend Mask greater(Avx512Lanes a, Avx512Lanes b) { return _mm512_cmp_ps_mask(a.value, b.value, _CMP_GT_OQ); }
+	friend Avx512Lanes select(Mask mask, Avx512Lanes a, Avx512Lanes b) { return _mm512_mask_blend_ps(mask, b.value, a.value); }
+
+};
+
+const BatchKernelTable& BatchKernels::getAvx512Kernels() {
+	static const BatchKernelTable table = BatchMetricFunctions<Avx512Lanes>::createKernelTable();
+	return table;
+}
+
+#endif
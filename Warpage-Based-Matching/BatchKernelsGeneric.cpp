@@ -0,0 +1,36 @@
+#include "BatchKernelTemplates.h"
+#include <cmath>
+
+// One quadrilateral at a time in plain floats, used when the processor has none of the vector extensions
+struct ScalarLanes {
+
+	const static size_t WIDTH = 1;
+
+	typedef bool Mask;
+
+	float value;
+
+	ScalarLanes() {}
+	ScalarLanes(float value) : value(value) {}
+
+	static ScalarLanes load(const float* data) { return ScalarLanes(*data); }
+	void store(float* data) const { *data = value; }
+
+	friend ScalarLanes operator+(ScalarLanes a, ScalarLanes b) { return ScalarLanes(a.value + b.value); }
+	friend ScalarLanes operator-(ScalarLanes a, ScalarLanes b) { return ScalarLanes(a.value - b.value); }
+	friend ScalarLanes operator*(ScalarLanes a, ScalarLanes b) { return ScalarLanes(a.value * b.value); }
+	friend ScalarLanes operator/(ScalarLanes a, ScalarLanes b) { return ScalarLanes(a.value / b.value); }
+
+	friend ScalarLanes sqrt(ScalarLanes a) { return ScalarLanes(std::sqrt(a.value)); }
+	friend ScalarLanes abs(ScalarLanes a) { return ScalarLanes(std::fabs(a.value)); }
+	friend ScalarLanes minimum(ScalarLanes a, ScalarLanes b) { return a.value < b.value ? a : b; }
+	friend ScalarLanes maximum(ScalarLanes a, ScalarLanes b) { return a.value > b.value ? a : b; }
+	friend Mask greater(ScalarLanes a, ScalarLanes b) { return a.value > b.value; }
+	friend ScalarLanes select(Mask mask, ScalarLanes a, ScalarLanes b) { return mask ? a : b; }
+
+};
+
+const BatchKernelTable& BatchKernels::getGenericKernels() {
+	static const BatchKernelTable table = BatchMetricFunctions<ScalarLanes>::createKernelTable();
+	return table;
+}
@@ -0,0 +1,42 @@
+#include "BatchKernelTemplates.h"
+
+#ifdef BATCH_KERNELS_X86
+
+#include <nmmintrin.h>
+
+// Four quadrilaterals at a time in SSE registers, the blend needs SSE4.1 and the file is built for SSE4.2
+struct Sse42Lanes {
+
+	const static size_t WIDTH = 4;
+
+	typedef __m128 Mask;
+
+	__m128 value;
+
+	Sse42Lanes() {}
+	Sse42Lanes(float value) : value(_mm_set1_ps(value)) {}
+	Sse42Lanes(__m128 value) : value(value) {}
+
+	static Sse42Lanes load(const float* data) { return _mm_loadu_ps(data); }
+	void store(float* data) const { _mm_storeu_ps(data, value); }
+
+	friend Sse42Lanes operator+(Sse42Lanes a, Sse42Lanes b) { return _mm_add_ps(a.value, b.value); }
+	friend Sse42Lanes operator-(Sse42Lanes a, Sse42Lanes b) { return _mm_sub_ps(a.value, b.value); }
+	friend Sse42Lanes operator*(Sse42Lanes a, Sse42Lanes b) { return _mm_mul_ps(a.value, b.value); }
+	friend Sse42Lanes operator/(Sse42Lanes a, Sse42Lanes b) { return _mm_div_ps(a.value, b.value); }
+
+	friend Sse42Lanes sqrt(Sse42Lanes a) { return _mm_sqrt_ps(a.value); }
+	friend Sse42Lanes abs(Sse42Lanes a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a.value); }
+	friend Sse42Lanes minimum(Sse42Lanes a, Sse42Lanes b) { return _mm_min_ps(a.value, b.value); }
+	friend Sse42Lanes maximum(Sse42Lanes a, Sse42Lanes b) { return _mm_max_ps(a.value, b.value); }
+	friend Mask greater(Sse42Lanes a, Sse42Lanes b) { return _mm_cmpgt_ps(a.value, b.value); }
+	friend Sse42Lanes select(Mask mask, Sse42Lanes a, Sse42Lanes b) { return _mm_blendv_ps(b.value, a.value, mask); }
+
+};
+
+const BatchKernelTable& BatchKernels::getSse42Kernels() {
+	static const BatchKernelTable table = BatchMetricFunctions<Sse42Lanes>::createKernelTable();
+	return table;
+}
+
+#endif
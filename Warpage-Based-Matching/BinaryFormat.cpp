@@ -0,0 +1,97 @@
+#include "BinaryFormat.h"
+#include <cstring>
+
+// Signatures of the binary mesh files, they cannot be mistaken for an OFF header
+static const char BINARY_MESH_MAGIC[8] = { 'W', 'B', 'M', 'M', 'E', 'S', 'H', '\x1a' };
+static const char BINARY_QUAD_MAGIC[8] = { 'W', 'B', 'M', 'Q', 'U', 'A', 'D', '\x1a' };
+
+uint64_t BinaryFormat::alignSize(uint64_t size) {
+	return (size + BINARY_BLOCK_ALIGNMENT - 1) / BINARY_BLOCK_ALIGNMENT * BINARY_BLOCK_ALIGNMENT;
+}
+
+bool BinaryFormat::isBinaryMesh(const char* data, size_t size) {
+	return size >= sizeof(BINARY_MESH_MAGIC) && memcmp(data, BINARY_MESH_MAGIC, sizeof(BINARY_MESH_MAGIC)) == 0;
+}
+
+BinaryMeshHeader BinaryFormat::createMeshHeader(uint64_t vertexCount, uint64_t faceCount) {
+
+	// Fill the identification fields
+	BinaryMeshHeader header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, BINARY_MESH_MAGIC, sizeof(BINARY_MESH_MAGIC));
+	header.version = BINARY_MESH_VERSION;
+	header.headerSize = sizeof(BinaryMeshHeader);
+
+	// Place the vertex and face blocks at aligned offsets after the header
+	header.vertexCount = vertexCount;
+	header.faceCount = faceCount;
+	header.vertexOffset = alignSize(sizeof(BinaryMeshHeader));
+	header.faceOffset = alignSize(header.vertexOffset + vertexCount * 3 * sizeof(float));
+	header.fileSize = alignSize(header.faceOffset + faceCount * 3 * sizeof(uint32_t));
+	return header;
+}
+
+BinaryQuadHeader BinaryFormat::createQuadHeader(uint64_t vertexCount, uint64_t quadCount, uint64_t triangleCount) {
+
+	// Fill the identification fields
+	BinaryQuadHeader header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, BINARY_QUAD_MAGIC, sizeof(BINARY_QUAD_MAGIC));
+	header.version = BINARY_MESH_VERSION;
+	header.headerSize = sizeof(BinaryQuadHeader);
+
+	// Place the vertex, quadrilateral, triangle and warpage blocks at aligned offsets after the header
+	header.vertexCount = vertexCount;
+	header.quadCount = quadCount;
+	header.triangleCount = triangleCount;
+	header.vertexOffset = alignSize(sizeof(BinaryQuadHeader));
+	header.quadOffset = alignSize(header.vertexOffset + vertexCount * 3 * sizeof(float));
+	header.triangleOffset = alignSize(header.quadOffset + quadCount * 4 * sizeof(uint32_t));
+	header.warpageOffset = alignSize(header.triangleOffset + triangleCount * 3 * sizeof(uint32_t));
+	header.fileSize = alignSize(header.warpageOffset + quadCount * sizeof(float));
+	return header;
+}
+
+bool BinaryFormat::checkMeshHeader(const BinaryMeshHeader &header, size_t fileSize, std::string &error) {
+
+	// Check the identification fields
+	if (memcmp(header.magic, BINARY_MESH_MAGIC, sizeof(BINARY_MESH_MAGIC)) != 0) {
+		error = "missing binary mesh signature";
+		return false;
+	}
+	if (header.version != BINARY_MESH_VERSION) {
+		error = "unsupported binary mesh version " + std::to_string(header.version);
+		return false;
+	}
+	if (header.headerSize != sizeof(BinaryMeshHeader)) {
+		error = "invalid header size";
+		return false;
+	}
+
+	// Indices are 32-bit, larger counts cannot be addressed and would overflow the block sizes
+	if (header.vertexCount > UINT32_MAX || header.faceCount > UINT32_MAX) {
+		error = "vertex and face counts exceed 32-bit indices";
+		return false;
+	}
+
+	// The blocks have to be aligned
+	uint64_t vertexSize = header.vertexCount * 3 * sizeof(float);
+	uint64_t faceSize = header.faceCount * 3 * sizeof(uint32_t);
+	if (header.vertexOffset % BINARY_BLOCK_ALIGNMENT != 0 || header.faceOffset % BINARY_BLOCK_ALIGNMENT != 0) {
+		error = "data blocks are not aligned";
+		return false;
+	}
+
+	// Every block has to be inside the file, the sizes are compared with the room after the offsets so no sum can overflow
+	if (header.fileSize != fileSize || header.vertexOffset > fileSize || vertexSize > fileSize - header.vertexOffset || header.faceOffset > fileSize || faceSize > fileSize - header.faceOffset) {
+		error = "file size does not match the header, the file may be truncated";
+		return false;
+	}
+
+	// The blocks have to follow the header and each other, the vertex block end is inside the file by now
+	if (header.vertexOffset < sizeof(BinaryMeshHeader) || header.faceOffset < header.vertexOffset + vertexSize) {
+		error = "data blocks overlap";
+		return false;
+	}
+	return true;
+}
@@ -0,0 +1,69 @@
+#ifndef BINARY_FORMAT
+#define BINARY_FORMAT
+
+#include <string>
+#include <cstddef>
+#include <cstdint>
+
+// Version of the binary mesh layout, files of other versions are rejected
+#define BINARY_MESH_VERSION 1
+
+// Alignment of the header and the data blocks in bytes
+#define BINARY_BLOCK_ALIGNMENT 64
+
+// Fixed size header at the start of a binary mesh file, all values are little-endian
+// The vertex block holds float32 xyz triples and the face block holds uint32 index triples
+struct BinaryMeshHeader {
+	char magic[8];
+	uint32_t version;
+	uint32_t headerSize;
+	uint64_t vertexCount;
+	uint64_t faceCount;
+	uint64_t vertexOffset;
+	uint64_t faceOffset;
+	uint64_t fileSize;
+	uint8_t reserved[8];
+};
+
+// Fixed size header at the start of a binary quadrilateral mesh file, all values are little-endian
+// The vertex block holds float32 xyz triples, the quadrilateral block uint32 index quadruples,
+// the triangle block the uint32 index triples of the unmatched faces and the warpage block one float32 per quadrilateral
+struct BinaryQuadHeader {
+	char magic[8];
+	uint32_t version;
+	uint32_t headerSize;
+	uint64_t vertexCount;
+	uint64_t quadCount;
+	uint64_t triangleCount;
+	uint64_t vertexOffset;
+	uint64_t quadOffset;
+	uint64_t triangleOffset;
+	uint64_t warpageOffset;
+	uint64_t fileSize;
+	uint8_t reserved[48];
+};
+
+static_assert(sizeof(BinaryMeshHeader) == BINARY_BLOCK_ALIGNMENT, "Binary mesh header must fill one block");
+static_assert(sizeof(BinaryQuadHeader) == 2 * BINARY_BLOCK_ALIGNMENT, "Binary quadrilateral header must fill two blocks");
+
+class BinaryFormat {
+public:
+
+	// Rounds the size up to the next block boundary
+	static uint64_t alignSize(uint64_t size);
+
+	// Returns true if the data starts with the binary mesh signature
+	static bool isBinaryMesh(const char* data, size_t size);
+
+	// Creates the header of a mesh with the given counts, blocks follow each other in order
+	static BinaryMeshHeader createMeshHeader(uint64_t vertexCount, uint64_t faceCount);
+
+	// Creates the header of a quadrilateral mesh with the given counts, blocks follow each other in order
+	static BinaryQuadHeader createQuadHeader(uint64_t vertexCount, uint64_t quadCount, uint64_t triangleCount);
+
+	// Checks the header against the file size, returns false and sets the error message if the file is invalid
+	static bool checkMeshHeader(const BinaryMeshHeader &header, size_t fileSize, std::string &error);
+
+};
+
+#endif
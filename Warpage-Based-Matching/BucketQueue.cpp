@@ -0,0 +1,117 @@
+#include "BucketQueue.h"
+#include "Definitions.h"
+#include <algorithm>
+
+BucketQueue::BucketQueue(size_t faceCount) {
+	heads.assign(BUCKET_COUNT + 1, INVALID_INDEX);
+	nextFaces.assign(faceCount, INVALID_INDEX);
+	previousFaces.assign(faceCount, INVALID_INDEX);
+	buckets.assign(faceCount, INVALID_INDEX);
+	lowestBucket = BUCKET_COUNT + 1;
+	size = 0;
+}
+
+void BucketQueue::build(const std::vector<double> &priorities) {
+
+	// Link the faces in index order, so the buckets come out the same as with separate insertions
+	size_t faceCount = priorities.size();
+	for (size_t face = 0; face < faceCount; face++) {
+		link((unsigned int) face, findBucket(priorities[face]));
+	}
+	size = faceCount;
+	pushCount += faceCount;
+	maximumSize = std::max(maximumSize, size);
+}
+
+void BucketQueue::update(unsigned int face, double priority) {
+
+	// Find the bucket of the new priority
+	unsigned int bucket = findBucket(priority);
+
+	// Move a queued face to its new bucket
+	if (buckets[face] != INVALID_INDEX) {
+		if (buckets[face] != bucket) {
+			unlink(face);
+			link(face, bucket);
+		}
+		updateCount++;
+		return;
+	}
+
+	// Insert a new face
+	link(face, bucket);
+	size++;
+	pushCount++;
+	maximumSize = std::max(maximumSize, size);
+}
+
+void BucketQueue::remove(unsigned int face) {
+
+	// Take the face out of its bucket if it is in the queue
+	if (buckets[face] != INVALID_INDEX) {
+		unlink(face);
+		size--;
+		removeCount++;
+	}
+}
+
+bool BucketQueue::pop(unsigned int &face) {
+
+	// The queue is empty
+	if (size == 0) {
+		return false;
+	}
+
+	// Find the lowest bucket with a face, the empty buckets below it stay empty until a lower priority is inserted
+	while (heads[lowestBucket] == INVALID_INDEX) {
+		lowestBucket++;
+	}
+
+	// Take the first face of the bucket
+	face = heads[lowestBucket];
+	unlink(face);
+	size--;
+	popCount++;
+	return true;
+}
+
+unsigned int BucketQueue::findBucket(double priority) {
+
+	// Priorities outside the range and invalid priorities go to the overflow bucket
+	if (!(priority >= 0.0 && priority <= MAXIMUM_BUCKET_PRIORITY)) {
+		return priority < 0.0 ? 0 : BUCKET_COUNT;
+	}
+	return std::min<unsigned int>((unsigned int) (priority / MAXIMUM_BUCKET_PRIORITY * BUCKET_COUNT), BUCKET_COUNT - 1);
+}
+
+void BucketQueue::link(unsigned int face, unsigned int bucket) {
+
+	// Put the face in front of the bucket list
+	unsigned int head = heads[bucket];
+	nextFaces[face] = head;
+	previousFaces[face] = INVALID_INDEX;
+	if (head != INVALID_INDEX) {
+		previousFaces[head] = face;
+	}
+	heads[bucket] = face;
+	buckets[face] = bucket;
+
+	// A face below the lowest bucket moves the search start back
+	lowestBucket = std::min<size_t>(lowestBucket, bucket);
+}
+
+void BucketQueue::unlink(unsigned int face) {
+
+	// Connect the neighbors of the face in the bucket list
+	unsigned int next = nextFaces[face];
+	unsigned int previous = previousFaces[face];
+	if (previous != INVALID_INDEX) {
+		nextFaces[previous] = next;
+	} else {
+		heads[buckets[face]] = next;
+	}
+	if (next != INVALID_INDEX) {
+		previousFaces[next] = previous;
+	}
+	buckets[face] = INVALID_INDEX;
+}
@@ -0,0 +1,51 @@
+#ifndef BUCKET_QUEUE
+#define BUCKET_QUEUE
+
+#include "FaceQueue.h"
+#include <vector>
+
+// Number of buckets that split the warpage range of [0, 180] degrees, larger priorities go to an overflow bucket
+#define BUCKET_COUNT 4096
+#define MAXIMUM_BUCKET_PRIORITY 180.0
+
+// Queue of faces in buckets of quantized priorities, faces in the same bucket come out in reverse insertion order
+// The lowest bucket is searched from the last popped bucket on, which is cheap as long as priorities mostly grow
+class BucketQueue : public FaceQueue {
+public:
+
+	// Constructor
+	BucketQueue(size_t faceCount);
+
+	void build(const std::vector<double> &priorities);
+	void update(unsigned int face, double priority);
+	void remove(unsigned int face);
+	bool pop(unsigned int &face);
+
+private:
+
+	// First face of every bucket, INVALID_INDEX for empty buckets
+	std::vector<unsigned int> heads;
+
+	// Neighbors of every face in its bucket list
+	std::vector<unsigned int> nextFaces;
+	std::vector<unsigned int> previousFaces;
+
+	// Bucket of every face, INVALID_INDEX if the face is not in the queue
+	std::vector<unsigned int> buckets;
+
+	// Lowest bucket that may hold a face
+	size_t lowestBucket;
+
+	// Number of faces in the queue
+	size_t size;
+
+	// Returns the bucket of the priority
+	static unsigned int findBucket(double priority);
+
+	// Adds the face to the front of the bucket or takes it out of its bucket
+	void link(unsigned int face, unsigned int bucket);
+	void unlink(unsigned int face);
+
+};
+
+#endif
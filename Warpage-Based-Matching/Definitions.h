@@ -4,35 +4,19 @@
 #include "Face.h"
 #include <map>
 
-typedef std::pair<unsigned int, unsigned int> VertexPair;
-
-struct HalfEdgeData;
-
-struct VertexData {
-	unsigned int id;
-	Vertex coordinate;
-	HalfEdgeData* half;
-};
+// Marks a missing vertex, face or half-edge index such as the twin of a boundary half-edge
+#define INVALID_INDEX 0xFFFFFFFFu
 
-struct FaceData {
-	bool matched = false;
-	bool processed = false;
-	unsigned int id;
-	double priority = 0;
-	HalfEdgeData* half;
-};
+typedef std::pair<unsigned int, unsigned int> VertexPair;
 
-struct HalfEdgeData {
-	bool matched = false;
-	VertexData* origin;
-	HalfEdgeData* pair;
-	HalfEdgeData* next;
-	FaceData* face;
+struct FacePriority {
+	double priority;
+	unsigned int face;
 };
 
 struct MinPriorityOrder {
-	bool operator()(FaceData* &lhs, FaceData* &rhs) {
-		return lhs->priority > rhs->priority;
+	bool operator()(const FacePriority &lhs, const FacePriority &rhs) const {
+		return lhs.priority > rhs.priority;
 	}
 };
 
@@ -0,0 +1,87 @@
+#include "EdgeMetricCache.h"
+#include "EvaluationFunctions.h"
+#include "BatchEvaluationFunctions.h"
+#include "ParallelFunctions.h"
+#include <algorithm>
+
+// Number of half-edges whose quadrilaterals are gathered into a batch at once
+#define PREFILL_BLOCK_SIZE 4096
+
+const double EdgeMetricCache::UNKNOWN_VALUE = -1.0;
+
+EdgeMetricCache::EdgeMetricCache(const TriangularMesh* mesh) {
+	this->mesh = mesh;
+	values.assign(mesh->getHalfEdgeCount(), UNKNOWN_VALUE);
+	hitCount = 0;
+	missCount = 0;
+	batchEvaluationCount = 0;
+}
+
+void EdgeMetricCache::prefill() {
+
+	// Every thread evaluates the edges of its own half-edge range block by block
+	std::vector<size_t> evaluationCounts(ParallelFunctions::getThreadCount(), 0);
+	ParallelFunctions::parallelFor(0, mesh->getHalfEdgeCount(), [&](size_t first, size_t last, unsigned int thread) {
+		QuadBatch batch;
+		std::vector<unsigned int> edges;
+		std::vector<float> results;
+		for (size_t begin = first; begin < last; begin += PREFILL_BLOCK_SIZE) {
+
+			// Collect the interior edges of the block that are not evaluated yet, every edge once through its smaller half-edge
+			size_t end = std::min<size_t>(begin + PREFILL_BLOCK_SIZE, last);
+			edges.clear();
+			for (size_t halfEdge = begin; halfEdge < end; halfEdge++) {
+				unsigned int twin = mesh->getTwin((unsigned int) halfEdge);
+				if (twin != INVALID_INDEX && halfEdge < twin && values[halfEdge] == UNKNOWN_VALUE) {
+					edges.push_back((unsigned int) halfEdge);
+				}
+			}
+
+			// Gather the corners of the quadrilaterals, the half-edge and its twin form the vertical diagonal
+			batch.resize(edges.size());
+			for (size_t i = 0; i < edges.size(); i++) {
+				unsigned int halfEdge = edges[i];
+				unsigned int twin = mesh->getTwin(halfEdge);
+				batch.set(i,
+					mesh->getCoordinate(mesh->getOrigin(halfEdge)),
+					mesh->getCoordinate(mesh->getOrigin(TriangularMesh::getPrevious(twin))),
+					mesh->getCoordinate(mesh->getOrigin(twin)),
+					mesh->getCoordinate(mesh->getOrigin(TriangularMesh::getPrevious(halfEdge))));
+			}
+
+			// Evaluate the batch and store the values
+			results.resize(edges.size());
+			BatchEvaluationFunctions::calculateMaximumWarpage(batch, results.data());
+			for (size_t i = 0; i < edges.size(); i++) {
+				values[edges[i]] = results[i];
+			}
+			evaluationCounts[thread] += edges.size();
+		}
+	}, PREFILL_BLOCK_SIZE);
+
+	// Sum the evaluations of the threads
+	for (size_t i = 0; i < evaluationCounts.size(); i++) {
+		batchEvaluationCount += evaluationCounts[i];
+	}
+}
+
+size_t EdgeMetricCache::getHitCount() const {
+	return hitCount;
+}
+
+size_t EdgeMetricCache::getMissCount() const {
+	return missCount;
+}
+
+size_t EdgeMetricCache::getBatchEvaluationCount() const {
+	return batchEvaluationCount;
+}
+
+double EdgeMetricCache::calculateMaximumWarpage(unsigned int edge) {
+
+	// Evaluate the quadrilateral on the edge once
+	missCount++;
+	double value = EvaluationFunctions::calculateMaximumWarpage(mesh, edge);
+	values[edge] = value;
+	return value;
+}
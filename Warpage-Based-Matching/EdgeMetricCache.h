@@ -0,0 +1,66 @@
+#ifndef EDGE_METRIC_CACHE
+#define EDGE_METRIC_CACHE
+
+#include "TriangularMesh.h"
+#include <vector>
+#include <algorithm>
+
+// Maximum warpage of the candidate quadrilateral on every interior edge, calculated on first use
+// An edge is stored under the smaller of its two half-edges, both half-edges form the same quadrilateral
+class EdgeMetricCache {
+public:
+
+	// Constructor, nothing is calculated until it is requested
+	EdgeMetricCache(const TriangularMesh* mesh);
+
+	// Returns the maximum warpage of the quadrilateral on the edge of the half-edge, the half-edge must have a twin
+	double getMaximumWarpage(unsigned int halfEdge) {
+
+		// Return the stored value if the edge is already evaluated
+		unsigned int edge = std::min(halfEdge, mesh->getTwin(halfEdge));
+		double value = values[edge];
+		if (value != UNKNOWN_VALUE) {
+			hitCount++;
+			return value;
+		}
+
+		// Evaluate the edge and store the value
+		return calculateMaximumWarpage(edge);
+	}
+
+	// Returns the stored maximum warpage without counting the request, it can be called from several threads after prefill
+	double getStoredMaximumWarpage(unsigned int halfEdge) const {
+		return values[std::min(halfEdge, mesh->getTwin(halfEdge))];
+	}
+
+	// Evaluates every interior edge that is not evaluated yet with the batch kernels on every thread
+	void prefill();
+
+	// Number of requests answered from the cache and evaluated on request
+	size_t getHitCount() const;
+	size_t getMissCount() const;
+
+	// Number of edges evaluated by prefill
+	size_t getBatchEvaluationCount() const;
+
+private:
+
+	// Marks the edges that are not evaluated yet, warpage is never negative
+	const static double UNKNOWN_VALUE;
+
+	// The mesh instance
+	const TriangularMesh* mesh;
+
+	// Metric values indexed by the smaller half-edge of the edge
+	std::vector<double> values;
+
+	size_t hitCount;
+	size_t missCount;
+	size_t batchEvaluationCount;
+
+	// Evaluates the edge and stores the value
+	double calculateMaximumWarpage(unsigned int edge);
+
+};
+
+#endif
@@ -4,53 +4,343 @@
 #include "Quadrilateral.h"
 #include "Triangle.h"
 #include "GeometricFunctions.h"
+#include "TriangularMesh.h"
+#include <functional>
+#include <algorithm>
+#include <cmath>
 
-enum AlignmentType {
-	HORIZONTAL,
-	VERTICAL
-};
-
+// The functions are defined inline below the class so the callers in every translation unit can inline them
 class EvaluationFunctions {
 public:
 	
 	// Calculates the minimum scaled jacobian metric value for a given quadrilateral
-	const static double calculateMinimumScaledJacobian(const Quadrilateral* quadrilateral);
+	const static double calculateMinimumScaledJacobian(const Quadrilateral &quadrilateral);
 
 	// Calculates the distortion amount for a given quadrilateral (Canaan)
-	const static double calculateDistortion(const Quadrilateral* quadrilateral);
+	const static double calculateDistortion(const Quadrilateral &quadrilateral);
 
 	// Calculates the distortion amount for a given quadrilateral (T-Base)
-	const static double calculateDistortion2(const Quadrilateral* quadrilateral);
+	const static double calculateDistortion2(const Quadrilateral &quadrilateral);
+
+	// Calculates the maximum warpage amount for a given quadrilateral, both diagonals are evaluated on the same edges
+	const static double calculateMaximumWarpage(const Quadrilateral &quadrilateral);
 
-	// Calculates the maximum warpage amount for a given quadrilateral
-	const static double calculateMaximumWarpage(const Quadrilateral* quadrilateral);
+	// Calculates the maximum warpage amount for the quadrilateral formed by the two faces sharing the half-edge
+	// The warpage on the shared diagonal is the angle between the face normals of the mesh
+	const static double calculateMaximumWarpage(const TriangularMesh* mesh, unsigned int halfEdge);
 
 	// Calculates the aspect-ratio for a given quadrilateral
-	const static double calculateAspectRatio(const Quadrilateral* quadrilateral);
+	const static double calculateAspectRatio(const Quadrilateral &quadrilateral);
 
 private:
 
 	// Calculates the determinant of the jacobian matrix
-	const static double calculateScaledJacobian(const Triangle* triangle);
+	const static double calculateScaledJacobian(const Triangle &triangle);
 
-	// Calculates the warpage amount for a given quadrilateral on given diagonal
-	const static double calculateWarpage(const Quadrilateral* quadrilateral, AlignmentType alignment);
+	// Calculates the angle in degrees between two normals of any length, NaN if either of them is zero
+	const static double calculateNormalAngle(double ax, double ay, double az, double bx, double by, double bz);
 
 	// Calculates the triangle distortion defined by Lee & Lo
-	const static double calculateTriangleDistortion(const Triangle* triangle);
+	const static double calculateTriangleDistortion(const Triangle &triangle);
 
 	// Calculates the average of the corner points in a quadrilateral
-	const static Vertex calculateCornerAverage(const Quadrilateral* quadrilateral);
+	const static Vertex calculateCornerAverage(const Quadrilateral &quadrilateral);
 
 	// Calculates the average of the normals on corner points in a quadrilateral
-	const static Normal calculateNormalAverage(const Quadrilateral* quadrilateral);
+	const static Normal calculateNormalAverage(const Quadrilateral &quadrilateral);
 
 	// Projects a triangle to the z=0 plane
-	const static void projectTriangle(Triangle* &triangle);
+	const static void projectTriangle(Triangle &triangle);
 
 	// Projects a non-planar quadrilateral onto an average plane
-	const static Quadrilateral projectQuadrilateral(const Quadrilateral* quadrilateral);
+	const static Quadrilateral projectQuadrilateral(const Quadrilateral &quadrilateral);
 
 };
 
+inline const double EvaluationFunctions::calculateMinimumScaledJacobian(const Quadrilateral &quadrilateral) {
+
+	// Create triangles for each corner on the stack
+	Triangle triangleABD{quadrilateral.a, quadrilateral.b, quadrilateral.d};
+	Triangle triangleBCA{quadrilateral.b, quadrilateral.c, quadrilateral.a};
+	Triangle triangleCDB{quadrilateral.c, quadrilateral.d, quadrilateral.b};
+	Triangle triangleDAC{quadrilateral.d, quadrilateral.a, quadrilateral.c};
+
+	// Project the triangle areas created by the edge vectors to the z=0 plane
+	projectTriangle(triangleABD);
+	projectTriangle(triangleBCA);
+	projectTriangle(triangleCDB);
+	projectTriangle(triangleDAC);
+
+	// Calculate the scaled jacobian values for each triangle
+	double scaledJacobianABD = calculateScaledJacobian(triangleABD);
+	double scaledJacobianBCA = calculateScaledJacobian(triangleBCA);
+	double scaledJacobianCDB = calculateScaledJacobian(triangleCDB);
+	double scaledJacobianDAC = calculateScaledJacobian(triangleDAC);
+
+	// Return the minimum scaled jacobian value
+	return std::min(std::min(scaledJacobianABD, scaledJacobianBCA), std::min(scaledJacobianCDB, scaledJacobianDAC));
+}
+
+inline const double EvaluationFunctions::calculateDistortion(const Quadrilateral &quadrilateral) {
+
+	// Find the intersection point of the diagonals AC and BD
+	// TODO - Diagonals of the concave quadrilaterals do not intersect
+	const Vertex intersection = GeometricFunctions::findLineIntersection(quadrilateral.a, quadrilateral.c, quadrilateral.b, quadrilateral.d);
+
+	// Create four triangles created by the diagonals on the stack
+	const Triangle triangleAB{quadrilateral.a, quadrilateral.b, intersection};
+	const Triangle triangleBC{quadrilateral.b, quadrilateral.c, intersection};
+	const Triangle triangleCD{quadrilateral.c, quadrilateral.d, intersection};
+	const Triangle triangleDA{quadrilateral.d, quadrilateral.a, intersection};
+
+	// Calculate the triangle distortion amounts
+	double alphaValues[Quadrilateral::POINT_COUNT];
+	alphaValues[0] = calculateTriangleDistortion(triangleAB);
+	alphaValues[1] = calculateTriangleDistortion(triangleBC);
+	alphaValues[2] = calculateTriangleDistortion(triangleCD);
+	alphaValues[3] = calculateTriangleDistortion(triangleDA);
+
+	// Sort the triangle distortion amounts
+	std::sort(std::begin(alphaValues), std::end(alphaValues), std::greater<double>());
+
+	// Calculate and return the quadrilateral distortion
+	return (alphaValues[2] * alphaValues[3]) / (alphaValues[0] * alphaValues[1]);
+}
+
+inline const double EvaluationFunctions::calculateDistortion2(const Quadrilateral &quadrilateral) {
+
+	// Calculate cross product for vertex A
+	const Vec3 AB(quadrilateral.a, quadrilateral.b);
+	const Vec3 AD(quadrilateral.a, quadrilateral.d);
+	double cpA = GeometricFunctions::crossProduct(AB, AD);
+
+	// Calculate cross product for vertex B
+	const Vec3 BC(quadrilateral.b, quadrilateral.c);
+	const Vec3 BA(quadrilateral.b, quadrilateral.a);
+	double cpB = GeometricFunctions::crossProduct(BC, BA);
+
+	// Calculate cross product for vertex C
+	const Vec3 CD(quadrilateral.c, quadrilateral.d);
+	const Vec3 CB(quadrilateral.c, quadrilateral.b);
+	double cpC = GeometricFunctions::crossProduct(CD, CB);
+
+	// Calculate cross product for vertex D
+	const Vec3 DA(quadrilateral.d, quadrilateral.a);
+	const Vec3 DC(quadrilateral.d, quadrilateral.c);
+	double cpD = GeometricFunctions::crossProduct(DA, DC);
+
+	// Calculate square length total values
+	double squareSumA = AB.getSquaredLength() + AD.getSquaredLength();
+	double squareSumB = BC.getSquaredLength() + BA.getSquaredLength();
+	double squareSumC = CD.getSquaredLength() + CB.getSquaredLength();
+	double squareSumD = DA.getSquaredLength() + DC.getSquaredLength();
+
+	// Calculate the nominator and denominator
+	double nominator = std::abs(cpA) + std::abs(cpB) + std::abs(cpC) + std::abs(cpD);
+	double denominator = squareSumA + squareSumB + squareSumC + squareSumD;
+
+	// Return the distortion value
+	return 2 * sqrt(sqrt(nominator / denominator));
+}
+
+inline const double EvaluationFunctions::calculateMaximumWarpage(const Quadrilateral &quadrilateral) {
+
+	// Both diagonals share the four edges leaving the corners A and C
+	double abX = (double) quadrilateral.b.x - quadrilateral.a.x, abY = (double) quadrilateral.b.y - quadrilateral.a.y, abZ = (double) quadrilateral.b.z - quadrilateral.a.z;
+	double adX = (double) quadrilateral.d.x - quadrilateral.a.x, adY = (double) quadrilateral.d.y - quadrilateral.a.y, adZ = (double) quadrilateral.d.z - quadrilateral.a.z;
+	double cbX = (double) quadrilateral.b.x - quadrilateral.c.x, cbY = (double) quadrilateral.b.y - quadrilateral.c.y, cbZ = (double) quadrilateral.b.z - quadrilateral.c.z;
+	double cdX = (double) quadrilateral.d.x - quadrilateral.c.x, cdY = (double) quadrilateral.d.y - quadrilateral.c.y, cdZ = (double) quadrilateral.d.z - quadrilateral.c.z;
+
+	// Calculate the angle between the normals of the triangles ABD and CDB for the horizontal diagonal
+	double horizontalWarpage = calculateNormalAngle(
+		abY * adZ - abZ * adY, abZ * adX - abX * adZ, abX * adY - abY * adX,
+		cdY * cbZ - cdZ * cbY, cdZ * cbX - cdX * cbZ, cdX * cbY - cdY * cbX);
+
+	// Calculate the angle between the normals of the triangles BCA and DAC for the vertical diagonal, BC x BA = CB x AB and DA x DC = AD x CD
+	double verticalWarpage = calculateNormalAngle(
+		cbY * abZ - cbZ * abY, cbZ * abX - cbX * abZ, cbX * abY - cbY * abX,
+		adY * cdZ - adZ * cdY, adZ * cdX - adX * cdZ, adX * cdY - adY * cdX);
+
+	// Return the horizontal warpage amount if it is greater, the vertical one elsewhere
+	if (horizontalWarpage > verticalWarpage) {
+		return horizontalWarpage;
+	}
+	return verticalWarpage;
+}
+
+inline const double EvaluationFunctions::calculateMaximumWarpage(const TriangularMesh* mesh, unsigned int halfEdge) {
+
+	// The half-edge and its twin form the vertical diagonal, its triangles are the faces themselves
+	unsigned int twin = mesh->getTwin(halfEdge);
+	const Vertex &normalDAC = mesh->getFaceNormal(TriangularMesh::getFace(halfEdge));
+	const Vertex &normalBCA = mesh->getFaceNormal(TriangularMesh::getFace(twin));
+	double verticalWarpage = calculateNormalAngle(normalBCA.x, normalBCA.y, normalBCA.z, normalDAC.x, normalDAC.y, normalDAC.z);
+
+	// Find the vertices of the quadrilateral for the horizontal diagonal
+	const Vertex &a = mesh->getCoordinate(mesh->getOrigin(halfEdge));
+	const Vertex &b = mesh->getCoordinate(mesh->getOrigin(TriangularMesh::getPrevious(twin)));
+	const Vertex &c = mesh->getCoordinate(mesh->getOrigin(twin));
+	const Vertex &d = mesh->getCoordinate(mesh->getOrigin(TriangularMesh::getPrevious(halfEdge)));
+
+	// Get the edges of the triangles on the horizontal diagonal
+	double abX = (double) b.x - a.x, abY = (double) b.y - a.y, abZ = (double) b.z - a.z;
+	double adX = (double) d.x - a.x, adY = (double) d.y - a.y, adZ = (double) d.z - a.z;
+	double cbX = (double) b.x - c.x, cbY = (double) b.y - c.y, cbZ = (double) b.z - c.z;
+	double cdX = (double) d.x - c.x, cdY = (double) d.y - c.y, cdZ = (double) d.z - c.z;
+
+	// Calculate the angle between the normals of the triangles on the horizontal diagonal
+	double horizontalWarpage = calculateNormalAngle(
+		abY * adZ - abZ * adY, abZ * adX - abX * adZ, abX * adY - abY * adX,
+		cdY * cbZ - cdZ * cbY, cdZ * cbX - cdX * cbZ, cdX * cbY - cdY * cbX);
+
+	// Return the horizontal warpage amount if it is greater, the vertical one elsewhere
+	if (horizontalWarpage > verticalWarpage) {
+		return horizontalWarpage;
+	}
+	return verticalWarpage;
+}
+
+inline const double EvaluationFunctions::calculateAspectRatio(const Quadrilateral &quadrilateral) {
+
+	// Project the quadrilateral onto a plane in case it is not planar
+	const Quadrilateral projectedQuadrilateral = projectQuadrilateral(quadrilateral);
+
+	// Find the middle point of the edges
+	const Vertex midAB = (projectedQuadrilateral.a + projectedQuadrilateral.b) / 2;
+	const Vertex midBC = (projectedQuadrilateral.b + projectedQuadrilateral.c) / 2;
+	const Vertex midCD = (projectedQuadrilateral.c + projectedQuadrilateral.d) / 2;
+	const Vertex midDA = (projectedQuadrilateral.d + projectedQuadrilateral.a) / 2;
+
+	// Create edges passing through the middle points
+	double verticalLength = Vec3(midAB, midCD).getLength();
+	double horizontalLength = Vec3(midBC, midDA).getLength();
+
+	// Calculate the aspect-ratio by dividing the longer edge by shorter one
+	double aspectRatio;
+	if (verticalLength > horizontalLength) {
+		aspectRatio = verticalLength / horizontalLength;
+	} else {
+		aspectRatio = horizontalLength / verticalLength;
+	}
+
+	// Return the aspect-ratio value
+	return aspectRatio;
+}
+
+inline const double EvaluationFunctions::calculateScaledJacobian(const Triangle &triangle) {
+
+	// Get the edge vectors on the projected triangle
+	const Vec3 left(triangle.a, triangle.c);
+	const Vec3 right(triangle.a, triangle.b);
+
+	// Calculate the determinant value for the absolute x-y components
+	double determinant = std::abs(left.x) * std::abs(right.y) - std::abs(right.x) * std::abs(left.y);
+
+	// Return the scaled Jacobian value
+	return determinant / left.getLength() / right.getLength();
+}
+
+inline const double EvaluationFunctions::calculateNormalAngle(double ax, double ay, double az, double bx, double by, double bz) {
+
+	// A zero normal has no direction
+	if ((ax == 0.0 && ay == 0.0 && az == 0.0) || (bx == 0.0 && by == 0.0 && bz == 0.0)) {
+		return NAN;
+	}
+
+	// The arc tangent of the cross and dot products stays accurate for nearly parallel normals unlike the arc cosine
+	double crossX = ay * bz - az * by;
+	double crossY = az * bx - ax * bz;
+	double crossZ = ax * by - ay * bx;
+	double cross = sqrt(crossX * crossX + crossY * crossY + crossZ * crossZ);
+	double dot = ax * bx + ay * by + az * bz;
+
+	// Return the angle in degrees
+	return atan2(cross, dot) * 180.0 / PI;
+}
+
+inline const double EvaluationFunctions::calculateTriangleDistortion(const Triangle &triangle) {
+
+	// Get the edges of the triangle
+	const Vec3 edgeAB(triangle.a, triangle.b);
+	const Vec3 edgeCA(triangle.c, triangle.a);
+	const Vec3 edgeCB(triangle.c, triangle.b);
+
+	// Calculate the nominator and denominator
+	const double areaElement = GeometricFunctions::crossProduct(edgeCA, edgeCB);
+	const double squareSum = edgeCA.getSquaredLength() + edgeAB.getSquaredLength() + edgeCB.getSquaredLength();
+
+	// Find the normal direction
+	int normalDirection;
+	if (areaElement > 0) {
+		normalDirection = 1;
+	} else {
+		normalDirection = -1;
+	}
+
+	// Return the triangle distortion value
+	return normalDirection * 2 * sqrt(3) * std::abs(areaElement) / squareSum;
+}
+
+inline const Vertex EvaluationFunctions::calculateCornerAverage(const Quadrilateral &quadrilateral) {
+
+	// Create and return the average vertex
+	return (quadrilateral.a + quadrilateral.b + quadrilateral.c + quadrilateral.d) / Quadrilateral::POINT_COUNT;
+}
+
+inline const Normal EvaluationFunctions::calculateNormalAverage(const Quadrilateral &quadrilateral) {
+
+	// Calculate the normals on the corner points
+	const Normal normalA = GeometricFunctions::findNormal(Vec3(quadrilateral.a, quadrilateral.b), Vec3(quadrilateral.a, quadrilateral.d));
+	const Normal normalB = GeometricFunctions::findNormal(Vec3(quadrilateral.b, quadrilateral.c), Vec3(quadrilateral.b, quadrilateral.a));
+	const Normal normalC = GeometricFunctions::findNormal(Vec3(quadrilateral.c, quadrilateral.d), Vec3(quadrilateral.c, quadrilateral.b));
+	const Normal normalD = GeometricFunctions::findNormal(Vec3(quadrilateral.d, quadrilateral.a), Vec3(quadrilateral.d, quadrilateral.c));
+
+	// Create the average normal
+	const Normal average = (normalA + normalB + normalC + normalD) / Quadrilateral::POINT_COUNT;
+
+	// Normalize the absolute components of the average normal into a unit vector
+	return Normal(std::abs(average.x), std::abs(average.y), std::abs(average.z)).normalize();
+}
+
+inline const void EvaluationFunctions::projectTriangle(Triangle &triangle) {
+
+	// Get the edge lengths of the triangle, left and right edges are adjacent to vertex A
+	double leftEdgeLength = Vec3(triangle.a, triangle.b).getLength();
+	double rightEdgeLength = Vec3(triangle.a, triangle.c).getLength();
+	double leftoverLength = Vec3(triangle.c, triangle.b).getLength();
+
+	// Calculate the x-y values for the third vertex
+	double x = (leftEdgeLength * leftEdgeLength - leftoverLength * leftoverLength + rightEdgeLength * rightEdgeLength) / (2 * rightEdgeLength);
+	double y = sqrt(leftEdgeLength * leftEdgeLength - x * x);
+
+	// Update the edge coordinates with vertices that are aligned with z=0 plane
+	triangle.a = Vertex(0, 0);
+	triangle.b = Vec3(x, y).toVertex();
+	triangle.c = Vec3(rightEdgeLength, 0).toVertex();
+}
+
+inline const Quadrilateral EvaluationFunctions::projectQuadrilateral(const Quadrilateral &quadrilateral) {
+
+	// Calculate the average of the corner points
+	const Vertex origin = calculateCornerAverage(quadrilateral);
+
+	// Calculate the average of the normals of the corner points
+	const Normal normal = calculateNormalAverage(quadrilateral);
+
+	// Create vectors from the origin to the each vertex of the quadrilateral
+	const Vec3 vectorA(origin, quadrilateral.a);
+	const Vec3 vectorB(origin, quadrilateral.b);
+	const Vec3 vectorC(origin, quadrilateral.c);
+	const Vec3 vectorD(origin, quadrilateral.d);
+
+	// Remove the distance to the plane found by the dot product of each vector with the normal, the projection is relative to the origin
+	const Vec3 projectedA = vectorA - normal * normal.dot(vectorA);
+	const Vec3 projectedB = vectorB - normal * normal.dot(vectorB);
+	const Vec3 projectedC = vectorC - normal * normal.dot(vectorC);
+	const Vec3 projectedD = vectorD - normal * normal.dot(vectorD);
+
+	// Return the quadrilateral with projected vertices
+	return Quadrilateral{projectedA.toVertex(), projectedB.toVertex(), projectedC.toVertex(), projectedD.toVertex()};
+}
+
 #endif
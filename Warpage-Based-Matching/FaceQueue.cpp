@@ -0,0 +1,83 @@
+#include "FaceQueue.h"
+#include "LazyHeapQueue.h"
+#include "IndexedHeapQueue.h"
+#include "BucketQueue.h"
+
+FaceQueue* FaceQueue::createQueue(QueueType type, size_t faceCount) {
+
+	// Create the queue of the requested type
+	switch (type) {
+	case LAZY_HEAP:
+		return new LazyHeapQueue(faceCount);
+	case QUANTIZED_BUCKETS:
+		return new BucketQueue(faceCount);
+	default:
+		return new IndexedHeapQueue(faceCount);
+	}
+}
+
+bool FaceQueue::parseType(const std::string &name, QueueType &type) {
+
+	// Compare the name with the name of each type
+	const QueueType types[] = { LAZY_HEAP, INDEXED_HEAP, QUANTIZED_BUCKETS };
+	for (size_t i = 0; i < sizeof(types) / sizeof(types[0]); i++) {
+		if (name == getTypeName(types[i])) {
+			type = types[i];
+			return true;
+		}
+	}
+
+	// Unknown type name
+	return false;
+}
+
+const char* FaceQueue::getTypeName(QueueType type) {
+
+	// Return the command line name of the type
+	switch (type) {
+	case LAZY_HEAP:
+		return "lazy";
+	case INDEXED_HEAP:
+		return "indexed";
+	case QUANTIZED_BUCKETS:
+		return "bucket";
+	}
+	return "unknown";
+}
+
+FaceQueue::FaceQueue() {
+	pushCount = 0;
+	updateCount = 0;
+	popCount = 0;
+	removeCount = 0;
+	staleCount = 0;
+	maximumSize = 0;
+}
+
+FaceQueue::~FaceQueue() {
+
+}
+
+size_t FaceQueue::getPushCount() const {
+	return pushCount;
+}
+
+size_t FaceQueue::getUpdateCount() const {
+	return updateCount;
+}
+
+size_t FaceQueue::getPopCount() const {
+	return popCount;
+}
+
+size_t FaceQueue::getRemoveCount() const {
+	return removeCount;
+}
+
+size_t FaceQueue::getStaleCount() const {
+	return staleCount;
+}
+
+size_t FaceQueue::getMaximumSize() const {
+	return maximumSize;
+}
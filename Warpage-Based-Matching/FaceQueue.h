@@ -0,0 +1,66 @@
+#ifndef FACE_QUEUE
+#define FACE_QUEUE
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+enum QueueType {
+	LAZY_HEAP,
+	INDEXED_HEAP,
+	QUANTIZED_BUCKETS
+};
+
+// Priority queue of faces where the face with the lowest priority comes first
+class FaceQueue {
+public:
+
+	// Creates a queue of the given type for the faces in [0, faceCount)
+	static FaceQueue* createQueue(QueueType type, size_t faceCount);
+
+	// Finds the queue type with the given name, returns false if there is no such type
+	static bool parseType(const std::string &name, QueueType &type);
+
+	// Returns the name of the queue type
+	static const char* getTypeName(QueueType type);
+
+	// Constructor
+	FaceQueue();
+
+	// Destructor
+	virtual ~FaceQueue();
+
+	// Inserts every face with its priority at once in linear time, the queue must be empty
+	virtual void build(const std::vector<double> &priorities) = 0;
+
+	// Inserts the face or changes its priority if it is already in the queue
+	virtual void update(unsigned int face, double priority) = 0;
+
+	// Removes the face if it is in the queue
+	virtual void remove(unsigned int face) = 0;
+
+	// Removes the face with the lowest priority, returns false if the queue is empty
+	virtual bool pop(unsigned int &face) = 0;
+
+	// Number of faces inserted, priorities changed in place, faces popped, faces removed and outdated entries skipped
+	size_t getPushCount() const;
+	size_t getUpdateCount() const;
+	size_t getPopCount() const;
+	size_t getRemoveCount() const;
+	size_t getStaleCount() const;
+
+	// Largest number of entries held at once
+	size_t getMaximumSize() const;
+
+protected:
+
+	size_t pushCount;
+	size_t updateCount;
+	size_t popCount;
+	size_t removeCount;
+	size_t staleCount;
+	size_t maximumSize;
+
+};
+
+#endif
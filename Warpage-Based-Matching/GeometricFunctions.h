@@ -2,10 +2,10 @@
 #define GEOMETRIC_FUNCTIONS
 
 #include "Quadrilateral.h"
+#include "Vec3.h"
 
 typedef Vertex Point;
-typedef Vector Edge;
-typedef Vector Normal;
+typedef Vec3 Normal;
 typedef double Angle;
 
 #define PI 3.14159265
@@ -14,40 +14,53 @@ class GeometricFunctions {
 public:
 	
 	// Calculates the dot product value of two vectors
-	static double dotProduct(const Vector &a, const Vector &b);
+	static constexpr double dotProduct(const Vec3 &a, const Vec3 &b) {
+		return a.dot(b);
+	}
 
-	// Calculates the cross product value of two vectors
-	static double crossProduct(const Vector &a, const Vector &b);
+	// Calculates the cross product value of two vectors, the components of the cross product vector are summed
+	static constexpr double crossProduct(const Vec3 &a, const Vec3 &b) {
+		const Vec3 product = a.cross(b);
+		return product.x + product.y + product.z;
+	}
 
 	// Checks whether a quadrilateral is concave or not
-	static bool checkConcavityByAngle(const Quadrilateral* quadrilateral);
+	static bool checkConcavityByAngle(const Quadrilateral &quadrilateral);
 
 	// Checks whether a quadrilateral is concave or not
-	static bool checkConcavityByIntersection(const Quadrilateral* quadrilateral);
+	static bool checkConcavityByIntersection(const Quadrilateral &quadrilateral);
 
 	// Checks whether a quadrilateral is planar or not
-	static bool checkPlanarity(const Quadrilateral* quadrilateral);
+	static bool checkPlanarity(const Quadrilateral &quadrilateral);
 
-	// Checks whether the two line segments intersect or not
-	static bool checkLineIntersection(const Edge &a, const Edge &b);
+	// Checks whether the line segments p1-p2 and q1-q2 intersect or not
+	static bool checkLineIntersection(const Point &p1, const Point &p2, const Point &q1, const Point &q2);
 
-	// Finds the intersection point of two line segments
-	const static Vertex findLineIntersection(const Edge &a, const Edge &b);
+	// Finds the intersection point of the lines through p1-p2 and q1-q2 in the x-y plane
+	static Point findLineIntersection(const Point &p1, const Point &p2, const Point &q1, const Point &q2);
 
-	// Calculates the normal vector of two vectors using the cross product
-	const static Normal findNormal(const Vector &a, const Vector &b);
+	// Calculates the normal vector of two vectors using the cross product, the normal is zero for parallel vectors
+	static constexpr Normal findNormal(const Vec3 &a, const Vec3 &b) {
+		return a.cross(b);
+	}
 
 	// Calculates the angle between two vectors
-	static Angle calculateAngle(const Vector &a, const Vector &b);
+	static Angle calculateAngle(const Vec3 &a, const Vec3 &b);
 
 	// Converts degrees to radians
-	static Angle degreesToRadians(const Angle angle);
+	static constexpr Angle degreesToRadians(const Angle angle) {
+		return angle * PI / 180.0;
+	}
 
 	// Converts radians to degrees
-	static Angle radiansToDegrees(const Angle angle);
+	static constexpr Angle radiansToDegrees(const Angle angle) {
+		return angle * 180.0 / PI;
+	}
 
 	// Normalizes the given vector to a unit vector
-	const static Vector normalizeVector(const Vector &vector);
+	static Vec3 normalizeVector(const Vec3 &vector) {
+		return vector.normalize();
+	}
 
 };
 
@@ -0,0 +1,221 @@
+#include "GreedyMatching.h"
+#include "ParallelFunctions.h"
+
+// Smallest number of faces handed to a thread while the initial priorities are calculated
+#define MINIMUM_PRIORITY_RANGE 4096
+
+GreedyMatching::GreedyMatching(const TriangularMesh* mesh, EdgeMetricCache* metricCache, QueueType queueType) : MatchingEngine(mesh, metricCache) {
+
+	// Match every face of the mesh
+	faceOrder = NULL;
+	facePositions = NULL;
+	firstPosition = 0;
+	localFaceCount = mesh->getFaceCount();
+
+	// Initially no face is matched or processed
+	matchedFlags.assign(localFaceCount, 0);
+	processedFlags.assign(localFaceCount, 0);
+
+	// Create the queue of the faces
+	priorityQueue = FaceQueue::createQueue(queueType, localFaceCount);
+}
+
+GreedyMatching::GreedyMatching(const TriangularMesh* mesh, EdgeMetricCache* metricCache, QueueType queueType, const std::vector<unsigned int> &faceOrder, const std::vector<unsigned int> &facePositions, size_t begin, size_t end) : MatchingEngine(mesh, metricCache) {
+
+	// Match the faces of the range only
+	this->faceOrder = &faceOrder;
+	this->facePositions = &facePositions;
+	firstPosition = begin;
+	localFaceCount = end - begin;
+
+	// Initially no face is matched or processed
+	matchedFlags.assign(localFaceCount, 0);
+	processedFlags.assign(localFaceCount, 0);
+
+	// Create the queue of the faces
+	priorityQueue = FaceQueue::createQueue(queueType, localFaceCount);
+}
+
+GreedyMatching::~GreedyMatching() {
+
+	// Delete the queue
+	delete priorityQueue;
+	priorityQueue = 0;
+}
+
+void GreedyMatching::initialize() {
+
+	// Calculate the priority of every face, no face is matched yet
+	std::vector<double> priorities(localFaceCount);
+	if (faceOrder) {
+
+		// Range engines already run on their own threads
+		for (size_t local = 0; local < localFaceCount; local++) {
+			priorities[local] = calculatePriority(getFace((unsigned int) local));
+		}
+	} else {
+		ParallelFunctions::parallelFor(0, localFaceCount, [this, &priorities](size_t first, size_t last, unsigned int) {
+			for (size_t face = first; face < last; face++) {
+				priorities[face] = calculatePriority((unsigned int) face);
+			}
+		}, MINIMUM_PRIORITY_RANGE);
+	}
+
+	// Store mesh triangles on the priority queue at once
+	priorityQueue->build(priorities);
+}
+
+void GreedyMatching::calculateMatching(std::map<unsigned int, unsigned int> &matching, std::vector<unsigned int> &unmatchedFaces) {
+
+	// Pop and try to match triangles until the priority queue is empty, matched faces are removed from the queue
+	unsigned int local;
+	while (priorityQueue->pop(local)) {
+
+		// Try to match the face with one of its neighbors, add it to the unmatched faces list if it fails
+		unsigned int currentFace = getFace(local);
+		int neighborId = matchFace(currentFace);
+		if (neighborId == -1) {
+			unmatchedFaces.push_back(currentFace);
+		} else {
+			matching[currentFace] = neighborId;
+		}
+
+		// Keep track of the processed face's id
+		processedFlags[local] = 1;
+	}
+}
+
+void GreedyMatching::calculatePartners(std::vector<unsigned int> &partners) {
+
+	// Pop and try to match triangles until the priority queue is empty, the faces left alone keep their partners
+	unsigned int local;
+	while (priorityQueue->pop(local)) {
+
+		// Try to match the face with one of its neighbors and store the pair on both faces
+		unsigned int currentFace = getFace(local);
+		int neighborId = matchFace(currentFace);
+		if (neighborId != -1) {
+			partners[currentFace] = (unsigned int) neighborId;
+			partners[neighborId] = currentFace;
+		}
+
+		// Keep track of the processed face's id
+		processedFlags[local] = 1;
+	}
+}
+
+void GreedyMatching::addStatistics(std::map<std::string, double> &statistics) const {
+
+	// Store the work done on the queue
+	statistics["queuePushCount"] = (double) priorityQueue->getPushCount();
+	statistics["queueUpdateCount"] = (double) priorityQueue->getUpdateCount();
+	statistics["queuePopCount"] = (double) priorityQueue->getPopCount();
+	statistics["queueRemoveCount"] = (double) priorityQueue->getRemoveCount();
+	statistics["queueStaleCount"] = (double) priorityQueue->getStaleCount();
+	statistics["queueMaximumSize"] = (double) priorityQueue->getMaximumSize();
+}
+
+int GreedyMatching::matchFace(unsigned int face) {
+
+	// Create a temporary variable to store the face with the highest priority
+	unsigned int highestFace = INVALID_INDEX;
+	unsigned int highestLocal = INVALID_INDEX;
+
+	// Iterate through each neighbor face in order to find the on with the highest priority
+	double minValue = 360;
+	unsigned int firstEdge = TriangularMesh::getHalfEdge(face);
+	for (unsigned int runner = firstEdge; runner < firstEdge + 3; runner++) {
+
+		// Get the current neighbor, boundary edges, neighbors outside the range and matched neighbors cannot form a quadrilateral
+		unsigned int twin = mesh->getTwin(runner);
+		if (twin == INVALID_INDEX) {
+			continue;
+		}
+		unsigned int pair = TriangularMesh::getFace(twin);
+		unsigned int pairLocal = getLocalIndex(pair);
+		if (pairLocal == INVALID_INDEX || matchedFlags[pairLocal]) {
+			continue;
+		}
+
+		// Calculate the metric value of the quadrilateral that consists of the face and the current pair
+		double currentValue = getMaximumWarpage(runner);
+
+		// Update the highest priority face if a more suitable face exists
+		if (currentValue < minValue) {
+			minValue = currentValue;
+			highestFace = pair;
+			highestLocal = pairLocal;
+		}
+	}
+
+	// If a match is found, update the neighboring faces and return true
+	if (minValue != 360) {
+
+		// Mark the faces as matched and take the neighbor out of the queue
+		matchedFlags[getLocalIndex(face)] = 1;
+		matchedFlags[highestLocal] = 1;
+		priorityQueue->remove(highestLocal);
+
+		// Update the neighbor priorities of the faces
+		updateNeighbors(face);
+		updateNeighbors(highestFace);
+
+		// Return the matched neighbor's id
+		return (int) highestFace;
+	}
+
+	// If all neighbors are previously matched, return -1
+	return -1;
+}
+
+void GreedyMatching::updateNeighbors(unsigned int face) {
+
+	// Update the priority of each neighbor face across the three edges
+	unsigned int firstEdge = TriangularMesh::getHalfEdge(face);
+	for (unsigned int halfEdge = firstEdge; halfEdge < firstEdge + 3; halfEdge++) {
+		unsigned int twin = mesh->getTwin(halfEdge);
+		if (twin != INVALID_INDEX) {
+			updatePriority(TriangularMesh::getFace(twin));
+		}
+	}
+}
+
+void GreedyMatching::updatePriority(unsigned int face) {
+
+	// Update the priority of the face depending on its neighbors if it is in the range and still waiting in the queue
+	unsigned int local = getLocalIndex(face);
+	if (local != INVALID_INDEX && !matchedFlags[local] && !processedFlags[local]) {
+		priorityQueue->update(local, calculatePriority(face));
+	}
+}
+
+double GreedyMatching::calculatePriority(unsigned int face) const {
+
+	// Initialize minimum metric value to 360
+	double minValue = 360;
+
+	// Iterate around the face
+	unsigned int firstEdge = TriangularMesh::getHalfEdge(face);
+	for (unsigned int runner = firstEdge; runner < firstEdge + 3; runner++) {
+
+		// Skip the boundary edges, the neighbors outside the range and the matched neighbors
+		unsigned int twin = mesh->getTwin(runner);
+		if (twin == INVALID_INDEX) {
+			continue;
+		}
+		unsigned int pairLocal = getLocalIndex(TriangularMesh::getFace(twin));
+		if (pairLocal != INVALID_INDEX && !matchedFlags[pairLocal]) {
+
+			// Read the metric value of the quadrilateral formed with the neighbor, it can be read from several threads
+			double currentValue = metricCache->getStoredMaximumWarpage(runner);
+
+			// Update the minimum value
+			if (currentValue < minValue) {
+				minValue = currentValue;
+			}
+		}
+	}
+
+	// Return the minimum metric result
+	return minValue;
+}
@@ -0,0 +1,78 @@
+#ifndef GREEDY_MATCHING
+#define GREEDY_MATCHING
+
+#include "MatchingEngine.h"
+
+// Sequential matching that pops the face with the best candidate quadrilateral from a queue and pairs it with that neighbor
+// The priorities of the neighbors are updated after every match
+class GreedyMatching : public MatchingEngine {
+public:
+
+	// Constructor, the faces are ordered with a queue of the given type
+	GreedyMatching(const TriangularMesh* mesh, EdgeMetricCache* metricCache, QueueType queueType);
+
+	// Constructor for the faces in [begin, end) of the face order, the positions give the place of every face in the order
+	// Only the edges between the faces of the range are considered, such engines can run on several threads once the metric cache is prefilled
+	GreedyMatching(const TriangularMesh* mesh, EdgeMetricCache* metricCache, QueueType queueType, const std::vector<unsigned int> &faceOrder, const std::vector<unsigned int> &facePositions, size_t begin, size_t end);
+
+	// Destructor
+	~GreedyMatching();
+
+	void initialize();
+	void calculateMatching(std::map<unsigned int, unsigned int> &matching, std::vector<unsigned int> &unmatchedFaces);
+	void addStatistics(std::map<std::string, double> &statistics) const;
+
+	// Calculates the matching into the partner array, only the partners of the faces in the range are written
+	void calculatePartners(std::vector<unsigned int> &partners);
+
+private:
+
+	// Face order and positions of a range engine, NULL if the engine matches the whole mesh
+	const std::vector<unsigned int>* faceOrder;
+	const std::vector<unsigned int>* facePositions;
+
+	// First position and number of the faces matched by the engine
+	size_t firstPosition;
+	size_t localFaceCount;
+
+	// Matched and processed flags of every face in the range
+	std::vector<unsigned char> matchedFlags;
+	std::vector<unsigned char> processedFlags;
+
+	// Priority queue to store the order of the faces
+	FaceQueue* priorityQueue;
+
+	// Returns the face at the local index
+	unsigned int getFace(unsigned int local) const {
+		return faceOrder ? (*faceOrder)[firstPosition + local] : local;
+	}
+
+	// Returns the local index of the face, INVALID_INDEX if the face is outside the range
+	unsigned int getLocalIndex(unsigned int face) const {
+		if (!faceOrder) {
+			return face;
+		}
+		size_t local = (*facePositions)[face] - firstPosition;
+		return local < localFaceCount ? (unsigned int) local : INVALID_INDEX;
+	}
+
+	// Returns the metric value of the quadrilateral on the edge, range engines only read the stored values so they can share the cache
+	double getMaximumWarpage(unsigned int halfEdge) {
+		return faceOrder ? metricCache->getStoredMaximumWarpage(halfEdge) : metricCache->getMaximumWarpage(halfEdge);
+	}
+
+	// Try to match a face with one of its neighbors and return matched face's id
+	int matchFace(unsigned int face);
+
+	// Update the priority of the neighbors of a matched face
+	void updateNeighbors(unsigned int face);
+
+	// Update the priority of a face depending on its neighbors
+	void updatePriority(unsigned int face);
+
+	// Calculates the priority of a face, the best metric value among the quadrilaterals with its free neighbors
+	double calculatePriority(unsigned int face) const;
+
+};
+
+#endif
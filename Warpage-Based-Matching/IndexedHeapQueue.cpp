@@ -0,0 +1,147 @@
+#include "IndexedHeapQueue.h"
+#include "Definitions.h"
+#include <algorithm>
+
+IndexedHeapQueue::IndexedHeapQueue(size_t faceCount) {
+	heap.reserve(faceCount);
+	positions.assign(faceCount, INVALID_INDEX);
+	priorities.assign(faceCount, 0);
+}
+
+void IndexedHeapQueue::build(const std::vector<double> &priorities) {
+
+	// Place the faces in index order
+	size_t faceCount = priorities.size();
+	this->priorities = priorities;
+	heap.resize(faceCount);
+	for (size_t face = 0; face < faceCount; face++) {
+		place((unsigned int) face, face);
+	}
+
+	// Restore the heap order from the last parent up to the root
+	if (faceCount > 1) {
+		for (size_t position = (faceCount - 2) / HEAP_ARITY + 1; position-- > 0;) {
+			siftDown(position);
+		}
+	}
+	pushCount += faceCount;
+	maximumSize = std::max(maximumSize, faceCount);
+}
+
+void IndexedHeapQueue::update(unsigned int face, double priority) {
+
+	// Insert a new face at the bottom of the heap
+	if (positions[face] == INVALID_INDEX) {
+		priorities[face] = priority;
+		heap.push_back(face);
+		positions[face] = (unsigned int) (heap.size() - 1);
+		siftUp(heap.size() - 1);
+		pushCount++;
+		maximumSize = std::max(maximumSize, heap.size());
+		return;
+	}
+
+	// Move a queued face in the direction of its priority change
+	double previous = priorities[face];
+	priorities[face] = priority;
+	if (priority < previous) {
+		siftUp(positions[face]);
+	} else if (priority > previous) {
+		siftDown(positions[face]);
+	}
+	updateCount++;
+}
+
+void IndexedHeapQueue::remove(unsigned int face) {
+
+	// Nothing to do if the face is not in the queue
+	unsigned int position = positions[face];
+	if (position == INVALID_INDEX) {
+		return;
+	}
+
+	// Fill the gap with the last face and restore the heap order around it
+	unsigned int last = heap.back();
+	heap.pop_back();
+	positions[face] = INVALID_INDEX;
+	if (last != face) {
+		place(last, position);
+		siftUp(position);
+		siftDown(positions[last]);
+	}
+	removeCount++;
+}
+
+bool IndexedHeapQueue::pop(unsigned int &face) {
+
+	// The queue is empty
+	if (heap.empty()) {
+		return false;
+	}
+
+	// Take the first face and move the last face to the top
+	face = heap[0];
+	unsigned int last = heap.back();
+	heap.pop_back();
+	positions[face] = INVALID_INDEX;
+	if (last != face) {
+		place(last, 0);
+		siftDown(0);
+	}
+	popCount++;
+	return true;
+}
+
+bool IndexedHeapQueue::isBefore(unsigned int lhs, unsigned int rhs) const {
+	return priorities[lhs] < priorities[rhs] || (priorities[lhs] == priorities[rhs] && lhs < rhs);
+}
+
+void IndexedHeapQueue::siftUp(size_t position) {
+
+	// Move the face up while it comes before its parent
+	unsigned int face = heap[position];
+	while (position > 0) {
+		size_t parent = (position - 1) / HEAP_ARITY;
+		if (!isBefore(face, heap[parent])) {
+			break;
+		}
+		place(heap[parent], position);
+		position = parent;
+	}
+	place(face, position);
+}
+
+void IndexedHeapQueue::siftDown(size_t position) {
+
+	// Move the face down while one of its children comes before it
+	unsigned int face = heap[position];
+	size_t size = heap.size();
+	while (true) {
+
+		// Find the first of the children
+		size_t firstChild = position * HEAP_ARITY + 1;
+		if (firstChild >= size) {
+			break;
+		}
+		size_t best = firstChild;
+		size_t lastChild = std::min(firstChild + HEAP_ARITY, size);
+		for (size_t child = firstChild + 1; child < lastChild; child++) {
+			if (isBefore(heap[child], heap[best])) {
+				best = child;
+			}
+		}
+
+		// Stop if the face comes before all of its children
+		if (!isBefore(heap[best], face)) {
+			break;
+		}
+		place(heap[best], position);
+		position = best;
+	}
+	place(face, position);
+}
+
+void IndexedHeapQueue::place(unsigned int face, size_t position) {
+	heap[position] = face;
+	positions[face] = (unsigned int) position;
+}
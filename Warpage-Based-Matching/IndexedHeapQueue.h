@@ -0,0 +1,46 @@
+#ifndef INDEXED_HEAP_QUEUE
+#define INDEXED_HEAP_QUEUE
+
+#include "FaceQueue.h"
+#include <vector>
+
+// Number of children of every heap node
+#define HEAP_ARITY 4
+
+// Implicit d-ary heap that knows the position of every face, so priorities are changed and faces removed in place
+// Faces with equal priorities are ordered by their index
+class IndexedHeapQueue : public FaceQueue {
+public:
+
+	// Constructor
+	IndexedHeapQueue(size_t faceCount);
+
+	void build(const std::vector<double> &priorities);
+	void update(unsigned int face, double priority);
+	void remove(unsigned int face);
+	bool pop(unsigned int &face);
+
+private:
+
+	// Faces in heap order
+	std::vector<unsigned int> heap;
+
+	// Heap position of every face, INVALID_INDEX if the face is not in the queue
+	std::vector<unsigned int> positions;
+
+	// Priority of every face
+	std::vector<double> priorities;
+
+	// Returns true if the first face comes before the second one
+	bool isBefore(unsigned int lhs, unsigned int rhs) const;
+
+	// Moves the face at the given position up or down until the heap order holds
+	void siftUp(size_t position);
+	void siftDown(size_t position);
+
+	// Places the face at the given heap position
+	void place(unsigned int face, size_t position);
+
+};
+
+#endif
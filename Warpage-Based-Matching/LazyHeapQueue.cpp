@@ -0,0 +1,68 @@
+#include "LazyHeapQueue.h"
+#include <algorithm>
+
+LazyHeapQueue::LazyHeapQueue(size_t faceCount) {
+	priorities.assign(faceCount, 0);
+	queued.assign(faceCount, 0);
+}
+
+void LazyHeapQueue::build(const std::vector<double> &priorities) {
+
+	// Collect an entry for every face and let the heap order them at once
+	size_t faceCount = priorities.size();
+	std::vector<FacePriority> entries(faceCount);
+	for (size_t face = 0; face < faceCount; face++) {
+		entries[face].priority = priorities[face];
+		entries[face].face = (unsigned int) face;
+	}
+	this->priorities = priorities;
+	queued.assign(faceCount, 1);
+	heap = std::priority_queue<FacePriority, std::vector<FacePriority>, MinPriorityOrder>(MinPriorityOrder(), std::move(entries));
+	pushCount += faceCount;
+	maximumSize = std::max(maximumSize, faceCount);
+}
+
+void LazyHeapQueue::update(unsigned int face, double priority) {
+
+	// Count the first insertion of a face as a push and the others as updates
+	if (queued[face]) {
+		updateCount++;
+	} else {
+		pushCount++;
+	}
+
+	// Push a new entry, the previous entry of the face becomes outdated
+	priorities[face] = priority;
+	queued[face] = 1;
+	FacePriority entry = { priority, face };
+	heap.push(entry);
+	maximumSize = std::max(maximumSize, heap.size());
+}
+
+void LazyHeapQueue::remove(unsigned int face) {
+
+	// The entries of the face stay in the heap until they are popped
+	if (queued[face]) {
+		queued[face] = 0;
+		removeCount++;
+	}
+}
+
+bool LazyHeapQueue::pop(unsigned int &face) {
+
+	// Skip the entries of removed faces and the entries with outdated priorities
+	while (!heap.empty()) {
+		FacePriority entry = heap.top();
+		heap.pop();
+		if (queued[entry.face] && priorities[entry.face] == entry.priority) {
+			queued[entry.face] = 0;
+			face = entry.face;
+			popCount++;
+			return true;
+		}
+		staleCount++;
+	}
+
+	// The queue is empty
+	return false;
+}
@@ -0,0 +1,33 @@
+#ifndef LAZY_HEAP_QUEUE
+#define LAZY_HEAP_QUEUE
+
+#include "FaceQueue.h"
+#include "Definitions.h"
+#include <vector>
+#include <queue>
+
+// Binary heap that pushes a new entry on every priority change and skips the outdated entries when they are popped
+// It holds more than one entry per face and is kept as a baseline for the indexed queues
+class LazyHeapQueue : public FaceQueue {
+public:
+
+	// Constructor
+	LazyHeapQueue(size_t faceCount);
+
+	void build(const std::vector<double> &priorities);
+	void update(unsigned int face, double priority);
+	void remove(unsigned int face);
+	bool pop(unsigned int &face);
+
+private:
+
+	// Entries of the faces, possibly outdated
+	std::priority_queue<FacePriority, std::vector<FacePriority>, MinPriorityOrder> heap;
+
+	// Current priority of every face and whether it is in the queue
+	std::vector<double> priorities;
+	std::vector<unsigned char> queued;
+
+};
+
+#endif
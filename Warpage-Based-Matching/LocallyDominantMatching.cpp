@@ -0,0 +1,133 @@
+#include "LocallyDominantMatching.h"
+#include "ParallelFunctions.h"
+
+// Smallest number of faces handed to a thread in a round
+#define MINIMUM_ROUND_RANGE 4096
+
+LocallyDominantMatching::LocallyDominantMatching(const TriangularMesh* mesh, EdgeMetricCache* metricCache) : MatchingEngine(mesh, metricCache) {
+
+	// Initially every face is free
+	size_t faceCount = mesh->getFaceCount();
+	partners.assign(faceCount, INVALID_INDEX);
+	candidates.assign(faceCount, INVALID_INDEX);
+	roundCount = 0;
+	candidateUpdateCount = 0;
+}
+
+void LocallyDominantMatching::initialize() {
+
+	// Find the candidate of every face on every thread
+	size_t faceCount = mesh->getFaceCount();
+	ParallelFunctions::parallelFor(0, faceCount, [this](size_t first, size_t last, unsigned int) {
+		for (size_t face = first; face < last; face++) {
+			candidates[face] = findCandidate((unsigned int) face);
+		}
+	}, MINIMUM_ROUND_RANGE);
+
+	// Every face with a candidate takes part in the first round
+	activeFaces.clear();
+	for (size_t face = 0; face < faceCount; face++) {
+		if (candidates[face] != INVALID_INDEX) {
+			activeFaces.push_back((unsigned int) face);
+		}
+	}
+}
+
+void LocallyDominantMatching::calculateMatching(std::map<unsigned int, unsigned int> &matching, std::vector<unsigned int> &unmatchedFaces) {
+
+	// The edge with the best value among the free faces is chosen from both sides, so every round matches at least one pair
+	while (!activeFaces.empty()) {
+		roundCount++;
+
+		// Match the faces pointing to each other, the pair is written by its smaller face only
+		ParallelFunctions::parallelFor(0, activeFaces.size(), [this](size_t first, size_t last, unsigned int) {
+			for (size_t i = first; i < last; i++) {
+				unsigned int face = activeFaces[i];
+				unsigned int candidate = candidates[face];
+				if (face < candidate && candidates[candidate] == face) {
+					partners[face] = candidate;
+					partners[candidate] = face;
+				}
+			}
+		}, MINIMUM_ROUND_RANGE);
+
+		// Update the candidates and drop the faces that are done
+		updateActiveFaces();
+	}
+
+	// Add the pairs under their smaller face and the faces left alone in increasing order
+	collectMatching(partners, matching, unmatchedFaces);
+}
+
+void LocallyDominantMatching::addStatistics(std::map<std::string, double> &statistics) const {
+
+	// Store the work done in the rounds
+	statistics["roundCount"] = (double) roundCount;
+	statistics["candidateUpdateCount"] = (double) candidateUpdateCount;
+}
+
+unsigned int LocallyDominantMatching::findCandidate(unsigned int face) const {
+
+	// Iterate through the free neighbors, the values are compared with the neighbor index as a tie breaker
+	unsigned int bestNeighbor = INVALID_INDEX;
+	double bestValue = 360;
+	unsigned int firstEdge = TriangularMesh::getHalfEdge(face);
+	for (unsigned int runner = firstEdge; runner < firstEdge + 3; runner++) {
+
+		// Boundary edges and matched neighbors cannot form a quadrilateral
+		unsigned int twin = mesh->getTwin(runner);
+		if (twin == INVALID_INDEX) {
+			continue;
+		}
+		unsigned int neighbor = TriangularMesh::getFace(twin);
+		if (partners[neighbor] != INVALID_INDEX) {
+			continue;
+		}
+
+		// Keep the neighbor with the smallest value, quadrilaterals without a value are never chosen
+		double value = metricCache->getStoredMaximumWarpage(runner);
+		if (value < bestValue || (value == bestValue && neighbor < bestNeighbor)) {
+			bestValue = value;
+			bestNeighbor = neighbor;
+		}
+	}
+
+	// Return the best neighbor
+	return bestNeighbor;
+}
+
+void LocallyDominantMatching::updateActiveFaces() {
+
+	// Every thread keeps the faces of its own range in order, the ranges are joined in order afterwards
+	unsigned int threadCount = ParallelFunctions::getThreadCount();
+	std::vector<std::vector<unsigned int> > keptFaces(threadCount);
+	std::vector<size_t> updateCounts(threadCount, 0);
+	ParallelFunctions::parallelFor(0, activeFaces.size(), [&](size_t first, size_t last, unsigned int thread) {
+		for (size_t i = first; i < last; i++) {
+
+			// Matched faces are done
+			unsigned int face = activeFaces[i];
+			if (partners[face] != INVALID_INDEX) {
+				continue;
+			}
+
+			// The free neighbor set only shrinks, so the candidate changes only if it was matched
+			if (partners[candidates[face]] != INVALID_INDEX) {
+				candidates[face] = findCandidate(face);
+				updateCounts[thread]++;
+			}
+
+			// Faces without a free neighbor stay unmatched
+			if (candidates[face] != INVALID_INDEX) {
+				keptFaces[thread].push_back(face);
+			}
+		}
+	}, MINIMUM_ROUND_RANGE);
+
+	// Join the faces of the ranges
+	activeFaces.clear();
+	for (unsigned int thread = 0; thread < threadCount; thread++) {
+		activeFaces.insert(activeFaces.end(), keptFaces[thread].begin(), keptFaces[thread].end());
+		candidateUpdateCount += updateCounts[thread];
+	}
+}
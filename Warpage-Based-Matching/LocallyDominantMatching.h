@@ -0,0 +1,42 @@
+#ifndef LOCALLY_DOMINANT_MATCHING
+#define LOCALLY_DOMINANT_MATCHING
+
+#include "MatchingEngine.h"
+
+// Parallel matching in rounds, every free face points to the free neighbor with the best candidate quadrilateral
+// Faces pointing to each other are matched, then the faces that lost their candidate look for a new one
+// Equal metric values are ordered by the face indices, so the matching is the same for every thread count
+class LocallyDominantMatching : public MatchingEngine {
+public:
+
+	// Constructor
+	LocallyDominantMatching(const TriangularMesh* mesh, EdgeMetricCache* metricCache);
+
+	void initialize();
+	void calculateMatching(std::map<unsigned int, unsigned int> &matching, std::vector<unsigned int> &unmatchedFaces);
+	void addStatistics(std::map<std::string, double> &statistics) const;
+
+private:
+
+	// Matched neighbor of every face, INVALID_INDEX while the face is free
+	std::vector<unsigned int> partners;
+
+	// Free neighbor with the best candidate quadrilateral of every face, INVALID_INDEX if there is none
+	std::vector<unsigned int> candidates;
+
+	// Free faces that still have a candidate in increasing order
+	std::vector<unsigned int> activeFaces;
+
+	// Number of rounds and candidates searched again after their neighbor was matched
+	size_t roundCount;
+	size_t candidateUpdateCount;
+
+	// Finds the free neighbor with the best candidate quadrilateral, INVALID_INDEX if every neighbor is matched
+	unsigned int findCandidate(unsigned int face) const;
+
+	// Keeps the active faces that are free and have a candidate, the candidates of the faces whose candidate was matched are searched again
+	void updateActiveFaces();
+
+};
+
+#endif
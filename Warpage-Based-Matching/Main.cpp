@@ -1,25 +1,38 @@
 #include "MeshReader.h"
 #include "MeshBuilder.h"
 #include "MeshWriter.h"
+#include "QualityReport.h"
 #include <iostream>
 #include <ctime>
 
 int main(int argc, char **argv) {
 
-	// Read the file name from command line
+	// Read the file name and the optional matching engine from command line
 	std::string filename = argv[1];
+	MatchingType matchingType = GREEDY_ENGINE;
+	if (argc > 2 && !MatchingEngine::parseType(argv[2], matchingType)) {
+		std::cerr << "Unknown matching engine: " << argv[2] << std::endl;
+		return 1;
+	}
 
 	// Read the triangular mesh from the given file
 	const TriangularMesh* mesh = MeshReader::getInstance()->readMesh(filename);
+	if (mesh == NULL) {
+		return 1;
+	}
 
 	// Output the total face count of the mesh
 	std::cout << "Face count: " << mesh->getFaceCount() << std::endl;
 
+	// Output the edges that cannot be shared by two faces
+	std::cout << "Boundary edge count: " << mesh->getBoundaryEdgeCount() << std::endl;
+	std::cout << "Non-manifold edge count: " << mesh->getNonManifoldEdgeCount() << std::endl;
+
 	// Start time of matching
 	const clock_t beginTime = clock();
 
 	// Initialize a mesh builder instance with the mesh read from the file
-	MeshBuilder* builder = new MeshBuilder(mesh);
+	MeshBuilder* builder = new MeshBuilder(mesh, INDEXED_HEAP, matchingType);
 
 	// Calculate the matching on the mesh
 	builder->calculateMatching();
@@ -29,15 +42,24 @@ int main(int argc, char **argv) {
 
 	// Output the time difference
 	float timeDifference = float(endTime - beginTime);
-	std::cout << "Running time: " << timeDifference / CLOCKS_PER_SEC;
+	std::cout << "Running time: " << timeDifference / CLOCKS_PER_SEC << std::endl;
+
+	// Output the quality of the resulting quadrilaterals
+	const QualityReport report(mesh, builder->getMatching());
+	for (int i = 0; i < QUALITY_METRIC_COUNT; i++) {
+		const MetricSummary &summary = report.getSummary((QualityMetric) i);
+		std::cout << QualityReport::getMetricName((QualityMetric) i) << ": min " << summary.minimum << ", mean " << summary.mean << ", max " << summary.maximum << std::endl;
+	}
 
 	// Write the quadrilateral mesh into an off file
-	// std::map<unsigned int, unsigned int> matching = builder->getMatching();
+	// const std::map<unsigned int, unsigned int> &matching = builder->getMatching();
 	// MeshWriter::getInstance()->writeMesh("output.off", mesh, matching);
 
-	// Delete the mesh builder instance
+	// Delete the mesh builder instance and the mesh
 	delete builder;
 	builder = 0;
+	delete mesh;
+	mesh = 0;
 
 	// Close the program on key press
 	getchar();
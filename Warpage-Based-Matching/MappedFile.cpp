@@ -0,0 +1,145 @@
+#include "MappedFile.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile() {
+	data = 0;
+	size = 0;
+#if defined(_WIN32)
+	fileHandle = INVALID_HANDLE_VALUE;
+	mappingHandle = 0;
+#endif
+}
+
+MappedFile::~MappedFile() {
+	close();
+}
+
+bool MappedFile::open(std::string filepath) {
+
+	// Release the previous mapping first
+	close();
+
+#if defined(_WIN32)
+
+	// Open the file and find its size
+	HANDLE file = CreateFileA(filepath.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if (file == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(file, &fileSize)) {
+		CloseHandle(file);
+		return false;
+	}
+	fileHandle = file;
+	size = (size_t) fileSize.QuadPart;
+
+	// Empty files cannot be mapped, they are represented with a null pointer
+	if (size == 0) {
+		return true;
+	}
+
+	// Map the whole file read-only
+	HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (mapping == NULL) {
+		close();
+		return false;
+	}
+	mappingHandle = mapping;
+	data = (const char*) MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (data == NULL) {
+		close();
+		return false;
+	}
+
+#else
+
+	// Open the file and find its size
+	int descriptor = ::open(filepath.c_str(), O_RDONLY);
+	if (descriptor < 0) {
+		return false;
+	}
+	struct stat status;
+	if (fstat(descriptor, &status) != 0) {
+		::close(descriptor);
+		return false;
+	}
+	size = (size_t) status.st_size;
+
+	// Empty files cannot be mapped, they are represented with a null pointer
+	if (size == 0) {
+		::close(descriptor);
+		return true;
+	}
+
+	// Map the whole file read-only, the mapping stays valid after the descriptor is closed
+	void* mapping = mmap(0, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+	::close(descriptor);
+	if (mapping == MAP_FAILED) {
+		size = 0;
+		return false;
+	}
+	data = (const char*) mapping;
+
+	// The file is read from start to end, let the kernel read ahead aggressively
+	madvise(mapping, size, MADV_SEQUENTIAL);
+
+#endif
+
+	return true;
+}
+
+void MappedFile::close() {
+
+#if defined(_WIN32)
+
+	// Release the view and the handles
+	if (data != 0) {
+		UnmapViewOfFile(data);
+	}
+	if (mappingHandle != 0) {
+		CloseHandle((HANDLE) mappingHandle);
+		mappingHandle = 0;
+	}
+	if (fileHandle != INVALID_HANDLE_VALUE) {
+		CloseHandle((HANDLE) fileHandle);
+		fileHandle = INVALID_HANDLE_VALUE;
+	}
+
+#else
+
+	// Release the mapping
+	if (data != 0) {
+		munmap((void*) data, size);
+	}
+
+#endif
+
+	data = 0;
+	size = 0;
+}
+
+void MappedFile::swap(MappedFile &file) {
+	std::swap(data, file.data);
+	std::swap(size, file.size);
+#if defined(_WIN32)
+	std::swap(fileHandle, file.fileHandle);
+	std::swap(mappingHandle, file.mappingHandle);
+#endif
+}
+
+const char* MappedFile::getData() const {
+	return data;
+}
+
+size_t MappedFile::getSize() const {
+	return size;
+}
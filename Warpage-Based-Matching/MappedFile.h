@@ -0,0 +1,52 @@
+#ifndef MAPPED_FILE
+#define MAPPED_FILE
+
+#include <string>
+#include <cstddef>
+#include <utility>
+
+class MappedFile {
+public:
+
+	// Constructor
+	MappedFile();
+
+	// Destructor, unmaps the file if it is still open
+	~MappedFile();
+
+	// Maps the whole file in the given location read-only, returns false if it cannot be mapped
+	bool open(std::string filepath);
+
+	// Unmaps the file
+	void close();
+
+	// Exchanges the mappings of the two files, used to hand a mapping over to its final owner
+	void swap(MappedFile &file);
+
+	// Returns the first byte of the mapped file
+	const char* getData() const;
+
+	// Returns the size of the mapped file in bytes
+	size_t getSize() const;
+
+private:
+
+	// Start of the mapping, null for empty or closed files
+	const char* data;
+
+	// Size of the mapping
+	size_t size;
+
+#if defined(_WIN32)
+	// Windows needs the file and mapping handles to release the view
+	void* fileHandle;
+	void* mappingHandle;
+#endif
+
+	// Mappings cannot be shared between owners
+	MappedFile(const MappedFile&);
+	MappedFile& operator=(const MappedFile&);
+
+};
+
+#endif
@@ -0,0 +1,85 @@
+#include "MatchingEngine.h"
+#include "GreedyMatching.h"
+#include "LocallyDominantMatching.h"
+#include "WorkStealingMatching.h"
+#include "PartitionedMatching.h"
+#include "OptimalMatching.h"
+#include "SortedMatching.h"
+
+MatchingEngine* MatchingEngine::createEngine(MatchingType type, const TriangularMesh* mesh, EdgeMetricCache* metricCache, QueueType queueType) {
+
+	// Create the engine of the requested type
+	switch (type) {
+	case LOCALLY_DOMINANT_ENGINE:
+		return new LocallyDominantMatching(mesh, metricCache);
+	case WORK_STEALING_ENGINE:
+		return new WorkStealingMatching(mesh, metricCache);
+	case PARTITIONED_ENGINE:
+		return new PartitionedMatching(mesh, metricCache, queueType);
+	case OPTIMAL_ENGINE:
+		return new OptimalMatching(mesh, metricCache, queueType);
+	case SORTED_ENGINE:
+		return new SortedMatching(mesh, metricCache);
+	default:
+		return new GreedyMatching(mesh, metricCache, queueType);
+	}
+}
+
+bool MatchingEngine::parseType(const std::string &name, MatchingType &type) {
+
+	// Compare the name with the name of each type
+	const MatchingType types[] = { GREEDY_ENGINE, LOCALLY_DOMINANT_ENGINE, WORK_STEALING_ENGINE, PARTITIONED_ENGINE, OPTIMAL_ENGINE, SORTED_ENGINE };
+	for (size_t i = 0; i < sizeof(types) / sizeof(types[0]); i++) {
+		if (name == getTypeName(types[i])) {
+			type = types[i];
+			return true;
+		}
+	}
+
+	// Unknown type name
+	return false;
+}
+
+const char* MatchingEngine::getTypeName(MatchingType type) {
+
+	// Return the command line name of the type
+	switch (type) {
+	case GREEDY_ENGINE:
+		return "greedy";
+	case LOCALLY_DOMINANT_ENGINE:
+		return "dominant";
+	case WORK_STEALING_ENGINE:
+		return "stealing";
+	case PARTITIONED_ENGINE:
+		return "partitioned";
+	case OPTIMAL_ENGINE:
+		return "optimal";
+	case SORTED_ENGINE:
+		return "sorted";
+	}
+	return "unknown";
+}
+
+MatchingEngine::MatchingEngine(const TriangularMesh* mesh, EdgeMetricCache* metricCache) {
+	this->mesh = mesh;
+	this->metricCache = metricCache;
+}
+
+MatchingEngine::~MatchingEngine() {
+
+}
+
+void MatchingEngine::addStatistics(std::map<std::string, double> &) const {
+
+}
+
+void MatchingEngine::collectMatching(const std::vector<unsigned int> &partners, std::map<unsigned int, unsigned int> &matching, std::vector<unsigned int> &unmatchedFaces) {
+	for (size_t face = 0; face < partners.size(); face++) {
+		unsigned int partner = partners[face];
+		if (partner == INVALID_INDEX) {
+			unmatchedFaces.push_back((unsigned int) face);
+		} else if (face < partner) {
+			matching.emplace_hint(matching.end(), (unsigned int) face, partner);
+		}
+	}
+}
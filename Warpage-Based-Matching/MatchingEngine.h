@@ -0,0 +1,61 @@
+#ifndef MATCHING_ENGINE
+#define MATCHING_ENGINE
+
+#include "TriangularMesh.h"
+#include "EdgeMetricCache.h"
+#include "FaceQueue.h"
+#include <vector>
+#include <map>
+#include <string>
+
+enum MatchingType {
+	GREEDY_ENGINE,
+	LOCALLY_DOMINANT_ENGINE,
+	WORK_STEALING_ENGINE,
+	PARTITIONED_ENGINE,
+	OPTIMAL_ENGINE,
+	SORTED_ENGINE
+};
+
+// Pairs the faces with their neighbors depending on the metric values of the candidate quadrilaterals
+class MatchingEngine {
+public:
+
+	// Creates an engine of the given type, the queue type is used by the engines that order the faces with a queue
+	static MatchingEngine* createEngine(MatchingType type, const TriangularMesh* mesh, EdgeMetricCache* metricCache, QueueType queueType);
+
+	// Finds the engine type with the given name, returns false if there is no such type
+	static bool parseType(const std::string &name, MatchingType &type);
+
+	// Returns the name of the engine type
+	static const char* getTypeName(MatchingType type);
+
+	// Constructor, the metric cache must be prefilled before the engine is initialized
+	MatchingEngine(const TriangularMesh* mesh, EdgeMetricCache* metricCache);
+
+	// Destructor
+	virtual ~MatchingEngine();
+
+	// Prepares the matching, called once before the matching is calculated
+	virtual void initialize() = 0;
+
+	// Calculates the matching, every matched pair is added to the map once and the faces left alone to the unmatched list
+	virtual void calculateMatching(std::map<unsigned int, unsigned int> &matching, std::vector<unsigned int> &unmatchedFaces) = 0;
+
+	// Adds the statistics of the engine
+	virtual void addStatistics(std::map<std::string, double> &statistics) const;
+
+protected:
+
+	// Adds every pair of the partner array to the map under its smaller face and the faces without partner to the list in increasing order
+	static void collectMatching(const std::vector<unsigned int> &partners, std::map<unsigned int, unsigned int> &matching, std::vector<unsigned int> &unmatchedFaces);
+
+	// The mesh instance
+	const TriangularMesh* mesh;
+
+	// Metric values of the candidate quadrilaterals on the edges
+	EdgeMetricCache* metricCache;
+
+};
+
+#endif
@@ -1,65 +1,32 @@
 #include "MeshBuilder.h"
-#include "Quadrilateral.h"
-#include "EvaluationFunctions.h"
+#include "AugmentingPathRepair.h"
+#include <chrono>
 #include <iostream>
 
-MeshBuilder::MeshBuilder(const TriangularMesh* mesh) {
-
-	// Store mesh triangles on a priority queue depending on the metric
-	const std::vector<FaceData*> faceList = mesh->getFaces();
-	for (size_t i = 0; i < mesh->getFaceCount(); i++) {
-
-		// Get the current face
-		FaceData* face = faceList[i];
-
-		// Initialize the priority of each face
-		updatePriority(face);
-
-		// Push the face into priority queue
-		priorityQueue.push(face);
-	}
+MeshBuilder::MeshBuilder(const TriangularMesh* mesh, QueueType queueType, MatchingType matchingType) : metricCache(mesh) {
 
 	// Store the mesh
 	this->mesh = mesh;
+
+	// Evaluate every candidate quadrilateral at once before the engine reads them
+	metricCache.prefill();
+
+	// Create the engine and let it initialize the priorities of the faces
+	matchingEngine = MatchingEngine::createEngine(matchingType, mesh, &metricCache, queueType);
+	matchingEngine->initialize();
 }
 
 MeshBuilder::~MeshBuilder() {
 
-	// Delete the mesh
-	delete mesh;
-	mesh = 0;
+	// Delete the engine, the mesh belongs to the caller
+	delete matchingEngine;
+	matchingEngine = 0;
 }
 
 void MeshBuilder::calculateMatching() {
 
-	// Pop and try to match triangles until the priority queue is empty
-	while (priorityQueue.size() != 0) {
-
-		// Take the face at the top of the queue and check if it is already matched
-		FaceData* currentFace = priorityQueue.top();
-
-		// Pop the face at the top in any case
-		priorityQueue.pop();
-
-		// Skip the faces that has already been processed
-		if (!currentFace->processed) {
-
-			// If the face is not already matched and encountered, try to find a matching
-			if (!currentFace->matched) {
-
-				// Try to match the face with one of its neighbors, add it to the unmatched faces list if it fails
-				int neighborId = matchFace(currentFace);
-				if (neighborId == -1) {
-					unmatchedFaces.push_back(currentFace);
-				} else {
-					matchingMap[currentFace->id] = neighborId;
-				}
-			}
-
-			// Keep track of the processed face's id
-			currentFace->processed = true;
-		}
-	}
+	// Let the engine pair the faces
+	matchingEngine->calculateMatching(matchingMap, unmatchedFaces);
 
 	// Calculate the matching percentage of the mesh
 	double faceCount = (double) mesh->getFaceCount();
@@ -68,138 +35,73 @@ void MeshBuilder::calculateMatching() {
 	// Print out the matching statistics
 	std::cout << "Unmatched face count: " << unmatchedFaces.size() << std::endl;
 	std::cout << "Matching percentage: " << matchingPercentage << std::endl;
-}
-
-int MeshBuilder::matchFace(FaceData* face) {
-
-	// Create a runner half edge to iterate around the face
-	HalfEdgeData* runner = face->half;
-
-	// Create a temporary variable to store the face with the highest priority
-	FaceData* highestFace = NULL;
-
-	// Create a temporary half-edge data to store on which half-edge the match has been found
-	HalfEdgeData* highestEdge = NULL;
-
-	// Iterate through each neighbor face in order to find the on with the highest priority
-	double minValue = 360;
-	do {
-
-		// Get the current neighbor
-		FaceData* pair = runner->pair->face;
-
-		// Calculate the metric value of the quadrilateral that consists of the face and the current pair
-		double currentValue = calculateMaximumWarpage(face, pair, runner);
-
-		// Update the highest priority face if a more suitable face exists
-		if (!pair->matched && currentValue < minValue) {
-			minValue = currentValue;
-			highestFace = pair;
-			highestEdge = runner;
-		}
-
-		// Update the runner pointer
-		runner = runner->next;
-
-	} while (runner != face->half);
 
-	// If a match is found, update the neighboring faces and return true
-	if (minValue != 360) {
-
-		// Mark the faces as matched
-		face->matched = true;
-		highestFace->matched = true;
-
-		// Mark the corresponding half-edges as matched
-		highestEdge->matched = true;
-		highestEdge->pair->matched = true;
-
-		// Update the neighbor priorities of the faces
-		updateNeighbors(face);
-		updateNeighbors(highestFace);
-
-		// Return the matched neighbor's id
-		return (int) highestFace->id;
-	}
-
-	// If all neighbors are previously matched, return -1
-	return -1;
-}
-
-void MeshBuilder::updateNeighbors(FaceData* face) {
-
-	// Update the priority of the first neighbor face
-	HalfEdgeData* halfEdge = face->half;
-	updatePriority(halfEdge->pair->face);
-
-	// Update the priority of the second neighbor face
-	halfEdge = halfEdge->next;
-	updatePriority(halfEdge->pair->face);
-
-	// Update the priority of the third neighbor face
-	halfEdge = halfEdge->next;
-	updatePriority(halfEdge->pair->face);
+	// Store the statistics of the matching
+	statistics["evaluationCount"] = (double) (metricCache.getMissCount() + metricCache.getBatchEvaluationCount());
+	statistics["batchEvaluationCount"] = (double) metricCache.getBatchEvaluationCount();
+	statistics["cacheHitCount"] = (double) metricCache.getHitCount();
+	statistics["cacheMissCount"] = (double) metricCache.getMissCount();
+	statistics["unmatchedFaceCount"] = (double) unmatchedFaces.size();
+	statistics["matchingPercentage"] = matchingPercentage;
+	matchingEngine->addStatistics(statistics);
 }
 
-void MeshBuilder::updatePriority(FaceData* face) {
-
-	// Update the priority of the face depending on its neighbors if it is not matched before
-	if (!face->matched) {
-
-		// Initialize minimum metric value to 360
-		double minValue = 360;
-
-		// Create a runner half edge to iterate around the face
-		HalfEdgeData* runner = face->half;
-		do {
+void MeshBuilder::repairMatching(unsigned int hopLimit, double warpageCap, double timeBudget) {
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
 
-			// Update the free neighbor count
-			FaceData* neighbor = runner->pair->face;
-			if (!neighbor->matched) {
-
-				// Calculate the metric value by forming a rectangle with two faces
-				double currentValue = calculateMaximumWarpage(face, neighbor, runner);
+	// Store the matched neighbor of every face
+	std::vector<unsigned int> partners(mesh->getFaceCount(), INVALID_INDEX);
+	for (std::map<unsigned int, unsigned int>::const_iterator it = matchingMap.begin(); it != matchingMap.end(); ++it) {
+		partners[it->first] = it->second;
+		partners[it->second] = it->first;
+	}
 
-				// Update the minimum value
-				if (currentValue < minValue) {
-					currentValue = minValue;
-				}
+	// Flip the augmenting paths
+	AugmentingPathRepair repair(mesh, &metricCache, hopLimit, warpageCap);
+	size_t repairedPairCount = repair.repair(partners, timeBudget);
+
+	// Rebuild the matching from the partners if pairs were added, every pair is stored under its smaller face
+	if (repairedPairCount > 0) {
+		matchingMap.clear();
+		unmatchedFaces.clear();
+		for (unsigned int face = 0; face < partners.size(); face++) {
+			if (partners[face] == INVALID_INDEX) {
+				unmatchedFaces.push_back(face);
+			} else if (face < partners[face]) {
+				matchingMap.emplace_hint(matchingMap.end(), face, partners[face]);
 			}
-
-			// Update the runner pointer
-			runner = runner->next;
-
-		} while (runner != face->half);
-
-		// Update the priority of the face with the maximum metric result
-		face->priority = minValue;
-
-		// This is an exploit to keep highest priority faces on top
-		if (!face->processed) {
-			priorityQueue.push(face);
 		}
 	}
-}
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
 
-double MeshBuilder::calculateMaximumWarpage(FaceData* face, FaceData* pair, HalfEdgeData* runner) {
-
-	// Find the vertices of the matching
-	const Vertex a = runner->origin->coordinate;
-	const Vertex b = runner->pair->next->next->origin->coordinate;
-	const Vertex c = runner->pair->origin->coordinate;
-	const Vertex d = runner->next->next->origin->coordinate;
-
-	// Construct the quadrilateral
-	const Quadrilateral* quadrilateral = new Quadrilateral(a, b, c, d);
+	// Calculate the matching percentage of the mesh
+	double faceCount = (double) mesh->getFaceCount();
+	double matchingPercentage = (faceCount - unmatchedFaces.size()) / faceCount * 100;
 
-	// Return the minimum scaled jacobian value
-	return EvaluationFunctions::calculateMaximumWarpage(quadrilateral);
+	// Print out the repair statistics
+	std::cout << "Repaired pair count: " << repairedPairCount << std::endl;
+	std::cout << "Unmatched face count after repair: " << unmatchedFaces.size() << std::endl;
+	std::cout << "Matching percentage after repair: " << matchingPercentage << std::endl;
+
+	// Store the statistics of the repair
+	statistics["repairedPairCount"] = (double) repairedPairCount;
+	statistics["repairRoundCount"] = (double) repair.getRoundCount();
+	statistics["repairSearchCount"] = (double) repair.getSearchCount();
+	statistics["repairConflictCount"] = (double) repair.getConflictCount();
+	statistics["repairTimedOut"] = repair.isTimedOut() ? 1.0 : 0.0;
+	statistics["repairSeconds"] = seconds;
+	statistics["unmatchedFaceCount"] = (double) unmatchedFaces.size();
+	statistics["matchingPercentage"] = matchingPercentage;
 }
 
-std::map<unsigned int, unsigned int> MeshBuilder::getMatching() {
+const std::map<unsigned int, unsigned int>& MeshBuilder::getMatching() const {
 	return matchingMap;
 }
 
-std::vector<FaceData*> MeshBuilder::getUnmatchedFaces() {
+const std::vector<unsigned int>& MeshBuilder::getUnmatchedFaces() const {
 	return unmatchedFaces;
 }
+
+const std::map<std::string, double>& MeshBuilder::getStatistics() const {
+	return statistics;
+}
@@ -2,27 +2,37 @@
 #define MESH_BUILDER
 
 #include "TriangularMesh.h"
+#include "EdgeMetricCache.h"
+#include "MatchingEngine.h"
 #include <vector>
-#include <queue>
 #include <map>
+#include <string>
 
 class MeshBuilder {
 public:
 
-	// Constructor
-	MeshBuilder(const TriangularMesh* mesh);
+	// Constructor, the matching is calculated by an engine of the given type, the greedy engine orders the faces with a queue of the given type
+	// The mesh is not owned by the builder and must outlive it
+	MeshBuilder(const TriangularMesh* mesh, QueueType queueType = INDEXED_HEAP, MatchingType matchingType = GREEDY_ENGINE);
 
 	// Destructor
 	~MeshBuilder();
 
-	// Calculates the heuristic matching of the triangles
+	// Calculates the matching of the triangles
 	void calculateMatching();
 
+	// Pairs unmatched faces along augmenting paths of at most the given number of edges after the matching is calculated
+	// Every new pair has at most the given warpage, the searches stop when the time budget in seconds runs out
+	void repairMatching(unsigned int hopLimit, double warpageCap, double timeBudget);
+
 	// Return the map of the matched triangles
-	std::map<unsigned int, unsigned int> getMatching();
+	const std::map<unsigned int, unsigned int>& getMatching() const;
 
 	// Return the list of unmatched faces
-	std::vector<FaceData*> getUnmatchedFaces();
+	const std::vector<unsigned int>& getUnmatchedFaces() const;
+
+	// Return the statistics of the matching calculation
+	const std::map<std::string, double>& getStatistics() const;
 
 private:
 
@@ -33,22 +43,16 @@ private:
 	std::map<unsigned int, unsigned int> matchingMap;
 
 	// Vector to store the faces that are not matched
-	std::vector<FaceData*> unmatchedFaces;
-
-	// Priority queue to store the order of the faces
-	std::priority_queue<FaceData*, std::vector<FaceData*>, MinPriorityOrder> priorityQueue;
-
-	// Try to match a face with one of its neighbors and return matched face's id
-	int matchFace(FaceData* face);
+	std::vector<unsigned int> unmatchedFaces;
 
-	// Update the priority of the neighbors of a matched face
-	void updateNeighbors(FaceData* face);
+	// Statistics of the matching calculation
+	std::map<std::string, double> statistics;
 
-	// Update the priority of a face depending on its neighbors
-	void updatePriority(FaceData* face);
+	// Metric values of the candidate quadrilaterals on the edges
+	EdgeMetricCache metricCache;
 
-	// Calculate maximum warpage metric using neighboring faces
-	double calculateMaximumWarpage(FaceData* face, FaceData* pair, HalfEdgeData* runner);
+	// Engine that calculates the matching
+	MatchingEngine* matchingEngine;
 
 };
 
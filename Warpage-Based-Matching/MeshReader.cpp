@@ -1,68 +1,301 @@
 #include "MeshReader.h"
-#include <fstream>
+#include "OffParser.h"
+#include "ParallelFunctions.h"
+#include <iostream>
+#include <algorithm>
+#include <cstring>
+#include <utility>
 
-MeshReader* MeshReader::instance;
+// Chunks are not split below this size since the thread startup would dominate
+#define MINIMUM_CHUNK_SIZE (1 << 20)
+
+MeshReader* MeshReader::instance = 0;
 
 MeshReader::MeshReader() {
-	instance = new MeshReader();
+
 }
 
 MeshReader::~MeshReader() {
-	delete instance;
-	instance = 0;
+
 }
 
 MeshReader* MeshReader::getInstance() {
+
+	// Create the singleton instance on first use
+	if (instance == 0) {
+		instance = new MeshReader();
+	}
+
+	// Return the singleton instance
 	return instance;
 }
 
 const TriangularMesh* MeshReader::readMesh(std::string filepath) {
 
-	// Open the file in given location
-	std::ifstream infile(filepath);
+	// Map the file in given location into memory
+	MappedFile file;
+	if (!file.open(filepath)) {
+		std::cerr << filepath << ": cannot open file" << std::endl;
+		return NULL;
+	}
+
+	// Binary meshes are constructed straight from the mapping
+	if (BinaryFormat::isBinaryMesh(file.getData(), file.getSize())) {
+		return readBinaryMesh(file, filepath);
+	}
+
+	// Parse the OFF records into vertex and face lists
+	std::vector<Vertex> vertexList;
+	std::vector<Face> faceList;
+	if (!readOffData(file, filepath, vertexList, faceList)) {
+		return NULL;
+	}
+
+	// Release the mapping before the mesh is constructed
+	file.close();
+
+	// Create the mesh using vertex and face list, the mesh takes over their memory
+	TriangularMesh* mesh = new TriangularMesh(std::move(vertexList), std::move(faceList));
+
+	// Return the resulting list
+	return mesh;
+}
 
-	// Read the file format
-	std::string format;
-	infile >> format;
+bool MeshReader::readMeshData(std::string filepath, std::vector<Vertex> &vertexList, std::vector<Face> &faceList) {
+
+	// Map the file in given location into memory
+	MappedFile file;
+	if (!file.open(filepath)) {
+		std::cerr << filepath << ": cannot open file" << std::endl;
+		return false;
+	}
+
+	// Parse OFF files, anything else has to be a binary mesh
+	if (!BinaryFormat::isBinaryMesh(file.getData(), file.getSize())) {
+		return readOffData(file, filepath, vertexList, faceList);
+	}
+
+	// Validate the binary mesh and copy its blocks into the lists
+	const BinaryMeshHeader* header = checkBinaryMesh(file, filepath);
+	if (header == NULL) {
+		return false;
+	}
+	const Vertex* vertices = reinterpret_cast<const Vertex*>(file.getData() + header->vertexOffset);
+	const Face* faces = reinterpret_cast<const Face*>(file.getData() + header->faceOffset);
+	vertexList.assign(vertices, vertices + header->vertexCount);
+	faceList.assign(faces, faces + header->faceCount);
+	return true;
+}
+
+bool MeshReader::readOffData(const MappedFile &file, const std::string &filepath, std::vector<Vertex> &vertexList, std::vector<Face> &faceList) {
+
+	// Parse the mapped characters from the start
+	const char* begin = file.getData();
+	const char* end = begin + file.getSize();
+	OffParser parser(begin, end);
 
 	// Read the mesh information
-	unsigned int numVertices, numFaces, numEdges;
-	infile >> numVertices >> numFaces >> numEdges;
+	unsigned int numVertices, numFaces;
+	if (!parser.readHeader(numVertices, numFaces)) {
+		std::cerr << filepath << ": " << parser.getError() << std::endl;
+		return false;
+	}
 
-	// Read the vertices from the file
-	std::vector<Vertex> vertexList(numVertices);
-	for (unsigned int i = 0; i < numVertices; i++) {
+	// Every record takes at least two characters, larger counts cannot be right and would only exhaust the memory
+	if ((size_t) numVertices + numFaces > file.getSize() / 2) {
+		std::cerr << filepath << ": vertex and face counts exceed the file size" << std::endl;
+		return false;
+	}
 
-		// Read vertex coordinates
-		float x, y, z;
-		infile >> x >> y >> z;
+	// Split the records after the header into chunks that start at line boundaries
+	const char* body = parser.getPosition();
+	size_t bodySize = end - body;
+	size_t chunkCount = std::max<size_t>(1, std::min<size_t>(ParallelFunctions::getThreadCount(), bodySize / MINIMUM_CHUNK_SIZE));
+	std::vector<OffChunk> chunks(chunkCount);
+	for (size_t i = 0; i < chunkCount; i++) {
+		chunks[i].begin = i == 0 ? body : chunks[i - 1].end;
+		chunks[i].end = i + 1 == chunkCount ? end : findLineStart(chunks[i].begin, body + bodySize * (i + 1) / chunkCount, end);
+	}
 
-		// Add it to the vertex list
-		vertexList[i] = Vertex(x, y, z);
+	// Count the records and lines of each chunk in parallel
+	if (chunkCount > 1) {
+		ParallelFunctions::parallelFor(0, chunkCount, [&chunks](size_t first, size_t last, unsigned int) {
+			for (size_t i = first; i < last; i++) {
+				countRecords(chunks[i]);
+			}
+		});
 	}
 
-	// Read the triangular faces from the file and creates a triangular mesh
-	std::vector<Face> faceList(numFaces);
-	for (unsigned int i = 0; i < numFaces; i++) {
+	// Find the first record and line of each chunk
+	size_t recordCount = 0;
+	size_t lineCount = parser.getLine();
+	for (size_t i = 0; i < chunkCount; i++) {
+		chunks[i].firstRecord = recordCount;
+		chunks[i].firstLine = lineCount;
+		recordCount += chunks[i].recordCount;
+		lineCount += chunks[i].lineCount;
+	}
 
-		// Read the number of vertices (always 4 for quadrilateral)
-		unsigned int vertexCount;
-		infile >> vertexCount;
+	// Parse the chunks in parallel, vertices go to their final place while faces are collected per chunk
+	vertexList.assign(numVertices, Vertex());
+	ParallelFunctions::parallelFor(0, chunkCount, [&](size_t first, size_t last, unsigned int) {
+		for (size_t i = first; i < last; i++) {
+			parseChunk(chunks[i], vertexList, numVertices, numFaces, chunkCount == 1);
+		}
+	});
 
-		// Read the quadrilateral vertices
-		unsigned int a, b, c;
-		infile >> a >> b >> c;
+	// Report the first error in file order
+	for (size_t i = 0; i < chunkCount; i++) {
+		if (!chunks[i].error.empty()) {
+			std::cerr << filepath << ": " << chunks[i].error << std::endl;
+			return false;
+		}
+	}
+	if (chunkCount > 1 && recordCount < (size_t) numVertices + numFaces) {
+		std::cerr << filepath << ": line " << lineCount << ": unexpected end of file, expected " << (recordCount < numVertices ? "a vertex" : "a face") << std::endl;
+		return false;
+	}
 
-		// Construct the triangle and add it to the list
-		faceList[i] = Face(a, b, c);
+	// Stitch the faces of the chunks together in order
+	std::vector<size_t> faceOffsets(chunkCount + 1, 0);
+	for (size_t i = 0; i < chunkCount; i++) {
+		faceOffsets[i + 1] = faceOffsets[i] + chunks[i].faces.size();
+	}
+	faceList.clear();
+	if (chunkCount == 1) {
+		faceList.swap(chunks[0].faces);
+	} else {
+		faceList.resize(faceOffsets[chunkCount]);
+		ParallelFunctions::parallelFor(0, chunkCount, [&](size_t first, size_t last, unsigned int) {
+			for (size_t i = first; i < last; i++) {
+				std::copy(chunks[i].faces.begin(), chunks[i].faces.end(), faceList.begin() + faceOffsets[i]);
+				std::vector<Face>().swap(chunks[i].faces);
+			}
+		});
 	}
 
-	// Close the input file
-	infile.close();
+	return true;
+}
 
-	// Create the mesh using vertex and face list
-	TriangularMesh* mesh = new TriangularMesh(vertexList, faceList);
+const BinaryMeshHeader* MeshReader::checkBinaryMesh(const MappedFile &file, const std::string &filepath) {
 
-	// Return the resulting list
+	// The header has to fit into the file before any of its fields are read
+	if (file.getSize() < sizeof(BinaryMeshHeader)) {
+		std::cerr << filepath << ": truncated binary mesh header" << std::endl;
+		return NULL;
+	}
+	const BinaryMeshHeader* header = reinterpret_cast<const BinaryMeshHeader*>(file.getData());
+	std::string error;
+	if (!BinaryFormat::checkMeshHeader(*header, file.getSize(), error)) {
+		std::cerr << filepath << ": " << error << std::endl;
+		return NULL;
+	}
+
+	// Check the face indices in parallel, the mesh construction trusts them
+	const uint32_t* indices = reinterpret_cast<const uint32_t*>(file.getData() + header->faceOffset);
+	size_t indexCount = header->faceCount * 3;
+	uint64_t vertexCount = header->vertexCount;
+	std::vector<size_t> invalidIndices(ParallelFunctions::getThreadCount(), indexCount);
+	ParallelFunctions::parallelFor(0, indexCount, [&](size_t first, size_t last, unsigned int thread) {
+		for (size_t i = first; i < last; i++) {
+			if (indices[i] >= vertexCount) {
+				invalidIndices[thread] = i;
+				return;
+			}
+		}
+	}, MINIMUM_CHUNK_SIZE);
+
+	// Report the first invalid index
+	size_t invalidIndex = *std::min_element(invalidIndices.begin(), invalidIndices.end());
+	if (invalidIndex < indexCount) {
+		std::cerr << filepath << ": face " << invalidIndex / 3 << ": vertex index " << indices[invalidIndex] << " out of range" << std::endl;
+		return NULL;
+	}
+	return header;
+}
+
+const TriangularMesh* MeshReader::readBinaryMesh(MappedFile &file, const std::string &filepath) {
+
+	// Validate the header and the face indices
+	const BinaryMeshHeader* header = checkBinaryMesh(file, filepath);
+	if (header == NULL) {
+		return NULL;
+	}
+
+	// Hand the mapping to the mesh, which reads the coordinates and indices in place without copying them
+	size_t vertexOffset = (size_t) header->vertexOffset;
+	size_t vertexCount = (size_t) header->vertexCount;
+	size_t faceOffset = (size_t) header->faceOffset;
+	size_t faceCount = (size_t) header->faceCount;
+	TriangularMesh* mesh = new TriangularMesh(file, vertexOffset, vertexCount, faceOffset, faceCount);
+
+	// Return the resulting mesh
 	return mesh;
 }
+
+const char* MeshReader::findLineStart(const char* begin, const char* position, const char* end) {
+
+	// Move the position past the next line break
+	const char* lineBreak = (const char*) memchr(position, '\n', end - position);
+	return lineBreak == 0 ? end : std::max(begin, lineBreak + 1);
+}
+
+void MeshReader::countRecords(OffChunk &chunk) {
+
+	// Every line that has something other than whitespace before a comment holds a record
+	chunk.recordCount = 0;
+	chunk.lineCount = 0;
+	const char* position = chunk.begin;
+	while (position < chunk.end) {
+
+		// Find the first meaningful character of the line
+		while (position < chunk.end && (*position == ' ' || *position == '\t' || *position == '\r' || *position == '\v' || *position == '\f')) {
+			position++;
+		}
+		if (position < chunk.end && *position != '\n' && *position != '#') {
+			chunk.recordCount++;
+		}
+
+		// Move to the next line
+		const char* lineBreak = (const char*) memchr(position, '\n', chunk.end - position);
+		if (lineBreak == 0) {
+			break;
+		}
+		position = lineBreak + 1;
+		chunk.lineCount++;
+	}
+}
+
+void MeshReader::parseChunk(OffChunk &chunk, std::vector<Vertex> &vertexList, unsigned int numVertices, unsigned int numFaces, bool wholeBody) {
+
+	// Records past the declared faces are ignored
+	size_t lastRecord = (size_t) numVertices + numFaces;
+	size_t recordCount = wholeBody ? lastRecord : chunk.recordCount;
+	size_t record = chunk.firstRecord;
+	size_t chunkEnd = std::min(record + recordCount, lastRecord);
+
+	// Chunks that start after the declared records hold only ignored records
+	if (record >= chunkEnd) {
+		return;
+	}
+
+	// Reserve space for the faces of the chunk, assuming most of them are triangles
+	if (chunkEnd > numVertices) {
+		chunk.faces.reserve(chunkEnd - std::max<size_t>(record, numVertices));
+	}
+
+	// Read the vertices and then the faces of the chunk
+	OffParser parser(chunk.begin, chunk.end, chunk.firstLine);
+	for (; record < chunkEnd && record < numVertices; record++) {
+		if (!parser.readVertex(vertexList[record])) {
+			chunk.error = parser.getError();
+			return;
+		}
+	}
+	for (; record < chunkEnd; record++) {
+		if (!parser.readFace(chunk.faces, numVertices)) {
+			chunk.error = parser.getError();
+			return;
+		}
+	}
+}
@@ -2,7 +2,22 @@
 #define MESH_READER
 
 #include "TriangularMesh.h"
+#include "BinaryFormat.h"
+#include "MappedFile.h"
 #include <string>
+#include <vector>
+
+// Part of the OFF records that is parsed by a single thread
+struct OffChunk {
+	const char* begin;
+	const char* end;
+	size_t firstRecord = 0;
+	size_t firstLine = 0;
+	size_t recordCount = 0;
+	size_t lineCount = 0;
+	std::vector<Face> faces;
+	std::string error;
+};
 
 class MeshReader {
 public:
@@ -10,9 +25,14 @@ public:
 	// Returns the singleton mesh reader instance
 	static MeshReader* getInstance();
 
-	// Reads the mesh in the given filepath
+	// Reads the OFF or binary mesh in the given filepath, returns null and prints the failing line if the file is invalid
+	// Large OFF files are split into line-aligned chunks that are parsed in parallel
+	// Binary meshes are mapped and constructed from the mapped blocks without parsing
 	const TriangularMesh* readMesh(std::string filepath);
 
+	// Reads the vertex and face lists of the OFF or binary mesh without constructing the mesh
+	bool readMeshData(std::string filepath, std::vector<Vertex> &vertexList, std::vector<Face> &faceList);
+
 private:
 
 	// Singleton mesh reader instance
@@ -24,6 +44,24 @@ private:
 	// Destructor
 	~MeshReader();
 
+	// Parses the OFF records of the mapped file into the vertex and face lists
+	static bool readOffData(const MappedFile &file, const std::string &filepath, std::vector<Vertex> &vertexList, std::vector<Face> &faceList);
+
+	// Validates the header and face indices of a mapped binary mesh, returns null if the file is invalid
+	static const BinaryMeshHeader* checkBinaryMesh(const MappedFile &file, const std::string &filepath);
+
+	// Constructs the mesh on the blocks of a mapped binary mesh, the mesh takes over the mapping if the file is valid
+	static const TriangularMesh* readBinaryMesh(MappedFile &file, const std::string &filepath);
+
+	// Returns the start of the line after the given position
+	static const char* findLineStart(const char* begin, const char* position, const char* end);
+
+	// Counts the records and line breaks in a chunk
+	static void countRecords(OffChunk &chunk);
+
+	// Parses the vertices and faces of a chunk, a chunk covering the whole body is parsed without counting
+	static void parseChunk(OffChunk &chunk, std::vector<Vertex> &vertexList, unsigned int numVertices, unsigned int numFaces, bool wholeBody);
+
 };
 
 #endif
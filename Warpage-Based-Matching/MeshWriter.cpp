@@ -1,75 +1,288 @@
 #include "MeshWriter.h"
-#include <fstream>
+#include "BinaryFormat.h"
+#include "ParallelFunctions.h"
+#include "EvaluationFunctions.h"
+#include <algorithm>
+#include <charconv>
 
-MeshWriter* MeshWriter::instance;
+// Number of records formatted by a thread before the buffers are written
+#define RECORDS_PER_BLOCK (1 << 16)
+
+// Upper bound of the characters of a formatted number, "-1.23457e+38" and 4294967295 both fit
+#define MAXIMUM_NUMBER_SIZE 16
+
+// Upper bounds of the characters of a vertex and a quadrilateral line
+#define MAXIMUM_VERTEX_RECORD_SIZE (3 * MAXIMUM_NUMBER_SIZE + 3)
+#define MAXIMUM_QUAD_RECORD_SIZE (5 * MAXIMUM_NUMBER_SIZE + 5)
+
+MeshWriter* MeshWriter::instance = 0;
 
 MeshWriter::MeshWriter() {
-	instance = new MeshWriter();
+
 }
 
 MeshWriter::~MeshWriter() {
-	delete instance;
-	instance = 0;
+
 }
 
 MeshWriter* MeshWriter::getInstance() {
+
+	// Create the singleton instance on first use
+	if (instance == 0) {
+		instance = new MeshWriter();
+	}
+
+	// Return the singleton instance
 	return instance;
 }
 
-void MeshWriter::writeMesh(std::string filepath, const TriangularMesh* mesh, std::map<unsigned int, unsigned int> matching) {
+bool MeshWriter::writeMesh(std::string filepath, const TriangularMesh* mesh, const std::map<unsigned int, unsigned int> &matching) {
 
 	// Delete output file first if it already exists
 	std::remove(filepath.c_str());
 
 	// Open the file in given location
-	std::ofstream outfile(filepath);
-
-	// Write the file format
-	outfile << "OFF" << std::endl;
+	FILE* outfile = fopen(filepath.c_str(), "wb");
+	if (outfile == NULL) {
+		return false;
+	}
 
-	// Calculate the mesh information
+	// Calculate the mesh information, only the matched quadrilaterals are written
 	unsigned int numVertices = mesh->getVertexCount();
-	unsigned int numFaces = mesh->getFaceCount() / 2;
+	unsigned int numFaces = matching.size();
 	unsigned int numEdges = numFaces * 4 / 2;
 
-	// Write the mesh information
-	outfile << numVertices << " " << numFaces << " " << numEdges << std::endl;
+	// Write the file format and the mesh information
+	char header[64];
+	int headerSize = snprintf(header, sizeof(header), "OFF\n%u %u %u\n", numVertices, numFaces, numEdges);
+	bool written = fwrite(header, 1, headerSize, outfile) == (size_t) headerSize;
+
+	// Write the vertex coordinates
+	written = written && writeRecords(outfile, numVertices, MAXIMUM_VERTEX_RECORD_SIZE, [mesh](size_t first, size_t last, char* position) {
+		for (size_t i = first; i < last; i++) {
+			position = formatVertex(position, mesh->getCoordinate(i));
+		}
+		return position;
+	});
 
-	// Write the vertices into the file
-	std::vector<VertexData*> vertexList = mesh->getVertices();
-	for (unsigned int i = 0; i < numVertices; i++) {
+	// Collect the matched face pairs so that the quadrilaterals can be formatted in parallel
+	std::vector<std::pair<unsigned int, unsigned int> > matchedFaces(matching.begin(), matching.end());
+
+	// Write the quadrilateral face vertices using matching map
+	written = written && writeRecords(outfile, matchedFaces.size(), MAXIMUM_QUAD_RECORD_SIZE, [mesh, &matchedFaces](size_t first, size_t last, char* position) {
+		for (size_t i = first; i < last; i++) {
 
-		// Get the vertex coordinates
-		Vertex vertex = vertexList[i]->coordinate;
+			// Output the vertices of the quadrilateral
+			unsigned int quad[4];
+			findQuadVertices(mesh, matchedFaces[i].first, matchedFaces[i].second, quad);
+			position = formatQuad(position, quad[0], quad[1], quad[2], quad[3]);
+		}
+		return position;
+	});
+
+	// Close the output file
+	return fclose(outfile) == 0 && written;
+}
 
-		// Write the vertex coordinates
-		outfile << vertex.x << " " << vertex.y << " " << vertex.z << std::endl;
+bool MeshWriter::writeBinaryMesh(std::string filepath, const std::vector<Vertex> &vertexList, const std::vector<Face> &faceList) {
+
+	// Open the file in given location
+	FILE* outfile = fopen(filepath.c_str(), "wb");
+	if (outfile == NULL) {
+		return false;
 	}
 
-	// Write the quadrilateral face vertices using matching map
-	std::vector<FaceData*> faceList = mesh->getFaces();
-	for (std::map<unsigned int, unsigned int>::iterator it = matching.begin(); it != matching.end(); it++) {
+	// Write the header followed by the vertex and face blocks
+	BinaryMeshHeader header = BinaryFormat::createMeshHeader(vertexList.size(), faceList.size());
+	uint64_t position = 0;
+	bool written = writeBlock(outfile, &header, sizeof(header), 0, position);
+	written = written && writeBlock(outfile, vertexList.data(), vertexList.size() * sizeof(Vertex), header.vertexOffset, position);
+	written = written && writeBlock(outfile, faceList.data(), faceList.size() * sizeof(Face), header.faceOffset, position);
+	written = written && writeBlock(outfile, NULL, 0, header.fileSize, position);
 
-		// Get the matched faces
-		FaceData* first = faceList[it->first];
-		FaceData* second = faceList[it->second];
+	// Close the output file
+	return fclose(outfile) == 0 && written;
+}
+
+bool MeshWriter::writeBinaryQuadMesh(std::string filepath, const TriangularMesh* mesh, const std::map<unsigned int, unsigned int> &matching, const std::vector<unsigned int> &unmatchedFaces) {
+
+	// Open the file in given location
+	FILE* outfile = fopen(filepath.c_str(), "wb");
+	if (outfile == NULL) {
+		return false;
+	}
 
-		// Find the matched edge that is shared between faces
-		HalfEdgeData* matchedEdge = first->half;
-		while (!matchedEdge->matched) {
-			matchedEdge = matchedEdge->next;
+	// The vertex coordinates are written straight from the mesh
+	ArrayView<Vertex> vertexList = mesh->getCoordinates();
+	size_t vertexCount = vertexList.size();
+
+	// Collect the matched face pairs
+	std::vector<std::pair<unsigned int, unsigned int> > matchedFaces(matching.begin(), matching.end());
+
+	// Find the vertices and the warpage of every quadrilateral in parallel
+	size_t quadCount = matchedFaces.size();
+	std::vector<uint32_t> quadList(quadCount * 4);
+	std::vector<float> warpageList(quadCount);
+	ParallelFunctions::parallelFor(0, quadCount, [&](size_t first, size_t last, unsigned int) {
+		for (size_t i = first; i < last; i++) {
+			unsigned int* quad = &quadList[i * 4];
+			unsigned int matchedEdge = findQuadVertices(mesh, matchedFaces[i].first, matchedFaces[i].second, quad);
+			warpageList[i] = (float) EvaluationFunctions::calculateMaximumWarpage(mesh, matchedEdge);
 		}
+	}, RECORDS_PER_BLOCK);
+
+	// Collect the vertices of the unmatched triangles
+	size_t triangleCount = unmatchedFaces.size();
+	std::vector<uint32_t> triangleList(triangleCount * 3);
+	for (size_t i = 0; i < triangleCount; i++) {
+		unsigned int halfEdge = TriangularMesh::getHalfEdge(unmatchedFaces[i]);
+		triangleList[i * 3] = mesh->getOrigin(halfEdge);
+		triangleList[i * 3 + 1] = mesh->getOrigin(halfEdge + 1);
+		triangleList[i * 3 + 2] = mesh->getOrigin(halfEdge + 2);
+	}
+
+	// Write the header followed by the vertex, quadrilateral, triangle and warpage blocks
+	BinaryQuadHeader header = BinaryFormat::createQuadHeader(vertexCount, quadCount, triangleCount);
+	uint64_t position = 0;
+	bool written = writeBlock(outfile, &header, sizeof(header), 0, position);
+	written = written && writeBlock(outfile, vertexList.data(), vertexList.size() * sizeof(Vertex), header.vertexOffset, position);
+	written = written && writeBlock(outfile, quadList.data(), quadList.size() * sizeof(uint32_t), header.quadOffset, position);
+	written = written && writeBlock(outfile, triangleList.data(), triangleList.size() * sizeof(uint32_t), header.triangleOffset, position);
+	written = written && writeBlock(outfile, warpageList.data(), warpageList.size() * sizeof(float), header.warpageOffset, position);
+	written = written && writeBlock(outfile, NULL, 0, header.fileSize, position);
+
+	// Close the output file
+	return fclose(outfile) == 0 && written;
+}
 
-		// Find the vertices of the matching
-		unsigned int a = matchedEdge->origin->id;
-		unsigned int b = matchedEdge->pair->next->next->origin->id;
-		unsigned int c = matchedEdge->pair->origin->id;
-		unsigned int d = matchedEdge->next->next->origin->id;
+bool MeshWriter::writeQuadrilateral(std::string filepath, const Quadrilateral &quadrilateral) {
 
-		// Output the vertices of the quadrilateral
-		outfile << "4 " << a << " " << b << " " << c << " " << d << std::endl;
+	// Write the corner points in order
+	const Vertex points[Quadrilateral::POINT_COUNT] = {quadrilateral.a, quadrilateral.b, quadrilateral.c, quadrilateral.d};
+	return writePolygon(filepath, points, Quadrilateral::POINT_COUNT);
+}
+
+bool MeshWriter::writeTriangle(std::string filepath, const Triangle &triangle) {
+
+	// Write the corner points in order
+	const Vertex points[Triangle::POINT_COUNT] = {triangle.a, triangle.b, triangle.c};
+	return writePolygon(filepath, points, Triangle::POINT_COUNT);
+}
+
+bool MeshWriter::writePolygon(std::string filepath, const Vertex* points, unsigned int pointCount) {
+
+	// Open the file in given location
+	FILE* outfile = fopen(filepath.c_str(), "wb");
+	if (outfile == NULL) {
+		return false;
+	}
+
+	// Write the file format with the vertex, face and edge counts
+	bool written = fprintf(outfile, "OFF\n%u 1 %u\n", pointCount, pointCount) > 0;
+
+	// Write the vertex coordinates
+	for (unsigned int i = 0; i < pointCount && written; i++) {
+		char buffer[MAXIMUM_VERTEX_RECORD_SIZE];
+		char* end = formatVertex(buffer, points[i]);
+		written = fwrite(buffer, 1, end - buffer, outfile) == (size_t) (end - buffer);
+	}
+
+	// Write the vertex order
+	written = written && fprintf(outfile, "%u", pointCount) > 0;
+	for (unsigned int i = 0; i < pointCount && written; i++) {
+		written = fprintf(outfile, " %u", i) > 0;
 	}
+	written = written && fprintf(outfile, "\n") > 0;
 
 	// Close the output file
-	outfile.close();
+	return fclose(outfile) == 0 && written;
+}
+
+unsigned int MeshWriter::findQuadVertices(const TriangularMesh* mesh, unsigned int face, unsigned int pair, unsigned int vertices[4]) {
+
+	// Find the matched edge that is shared between faces
+	unsigned int matchedEdge = mesh->findSharedHalfEdge(face, pair);
+
+	// Find the vertices of the matching
+	unsigned int twin = mesh->getTwin(matchedEdge);
+	vertices[0] = mesh->getOrigin(matchedEdge);
+	vertices[1] = mesh->getOrigin(TriangularMesh::getPrevious(twin));
+	vertices[2] = mesh->getOrigin(twin);
+	vertices[3] = mesh->getOrigin(TriangularMesh::getPrevious(matchedEdge));
+	return matchedEdge;
+}
+
+bool MeshWriter::writeBlock(FILE* outfile, const void* data, size_t size, uint64_t offset, uint64_t &position) {
+
+	// Fill the gap before the block with zeros
+	static const char padding[BINARY_BLOCK_ALIGNMENT] = { 0 };
+	while (position < offset) {
+		size_t gap = (size_t) std::min<uint64_t>(offset - position, sizeof(padding));
+		if (fwrite(padding, 1, gap, outfile) != gap) {
+			return false;
+		}
+		position += gap;
+	}
+
+	// Write the block itself
+	if (size != 0 && fwrite(data, 1, size, outfile) != size) {
+		return false;
+	}
+	position += size;
+	return true;
+}
+
+bool MeshWriter::writeRecords(FILE* outfile, size_t recordCount, size_t recordSize, const std::function<char*(size_t, size_t, char*)> &format) {
+
+	// Every thread formats a block of records into its own buffer
+	size_t threadCount = ParallelFunctions::getThreadCount();
+	std::vector<std::vector<char> > buffers(threadCount, std::vector<char>(RECORDS_PER_BLOCK * recordSize));
+	std::vector<size_t> lengths(threadCount);
+
+	// Format a batch of blocks in parallel and then write them in file order
+	for (size_t batch = 0; batch < recordCount; batch += RECORDS_PER_BLOCK * threadCount) {
+		size_t blockCount = std::min(threadCount, (recordCount - batch + RECORDS_PER_BLOCK - 1) / RECORDS_PER_BLOCK);
+		ParallelFunctions::parallelFor(0, blockCount, [&](size_t first, size_t last, unsigned int) {
+			for (size_t block = first; block < last; block++) {
+				size_t begin = batch + block * RECORDS_PER_BLOCK;
+				size_t end = std::min(begin + RECORDS_PER_BLOCK, recordCount);
+				char* buffer = buffers[block].data();
+				lengths[block] = format(begin, end, buffer) - buffer;
+			}
+		});
+		for (size_t block = 0; block < blockCount; block++) {
+			if (fwrite(buffers[block].data(), 1, lengths[block], outfile) != lengths[block]) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+char* MeshWriter::formatVertex(char* position, const Vertex &vertex) {
+
+	// Use six significant digits like the default stream formatting
+	position = std::to_chars(position, position + MAXIMUM_NUMBER_SIZE, vertex.x, std::chars_format::general, 6).ptr;
+	*position++ = ' ';
+	position = std::to_chars(position, position + MAXIMUM_NUMBER_SIZE, vertex.y, std::chars_format::general, 6).ptr;
+	*position++ = ' ';
+	position = std::to_chars(position, position + MAXIMUM_NUMBER_SIZE, vertex.z, std::chars_format::general, 6).ptr;
+	*position++ = '\n';
+	return position;
+}
+
+char* MeshWriter::formatQuad(char* position, unsigned int a, unsigned int b, unsigned int c, unsigned int d) {
+
+	// Write the vertex count followed by the indices
+	*position++ = '4';
+	*position++ = ' ';
+	position = std::to_chars(position, position + MAXIMUM_NUMBER_SIZE, a).ptr;
+	*position++ = ' ';
+	position = std::to_chars(position, position + MAXIMUM_NUMBER_SIZE, b).ptr;
+	*position++ = ' ';
+	position = std::to_chars(position, position + MAXIMUM_NUMBER_SIZE, c).ptr;
+	*position++ = ' ';
+	position = std::to_chars(position, position + MAXIMUM_NUMBER_SIZE, d).ptr;
+	*position++ = '\n';
+	return position;
 }
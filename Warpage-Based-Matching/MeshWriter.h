@@ -2,7 +2,12 @@
 #define MESH_WRITER
 
 #include "TriangularMesh.h"
+#include "Quadrilateral.h"
+#include "Triangle.h"
 #include <string>
+#include <functional>
+#include <cstdio>
+#include <cstdint>
 
 class MeshWriter {
 public:
@@ -10,8 +15,21 @@ public:
 	// Returns the singleton mesh writer instance
 	static MeshWriter* getInstance();
 
-	// Writes the quadrilateral mesh to the given file
-	void writeMesh(std::string filepath, const TriangularMesh* mesh, std::map<unsigned int, unsigned int> matching);
+	// Writes the quadrilateral mesh to the given file, lines are formatted in parallel and written in large blocks
+	// Returns false if the file cannot be written
+	bool writeMesh(std::string filepath, const TriangularMesh* mesh, const std::map<unsigned int, unsigned int> &matching);
+
+	// Writes the triangle lists in the binary mesh format, returns false if the file cannot be written
+	bool writeBinaryMesh(std::string filepath, const std::vector<Vertex> &vertexList, const std::vector<Face> &faceList);
+
+	// Writes the quadrilateral mesh in the binary format together with the unmatched triangles and the warpage of every quadrilateral
+	bool writeBinaryQuadMesh(std::string filepath, const TriangularMesh* mesh, const std::map<unsigned int, unsigned int> &matching, const std::vector<unsigned int> &unmatchedFaces);
+
+	// Writes a single quadrilateral as an OFF file for inspection, returns false if the file cannot be written
+	bool writeQuadrilateral(std::string filepath, const Quadrilateral &quadrilateral);
+
+	// Writes a single triangle as an OFF file for inspection, returns false if the file cannot be written
+	bool writeTriangle(std::string filepath, const Triangle &triangle);
 
 private:
 
@@ -24,6 +42,26 @@ private:
 	// Destructor
 	~MeshWriter();
 
+	// Formats the records in blocks on every thread and writes the blocks in order
+	// The format function fills the buffer with the records of a range and returns the end of the written characters
+	// Returns false if a block cannot be written
+	static bool writeRecords(FILE* outfile, size_t recordCount, size_t recordSize, const std::function<char*(size_t, size_t, char*)> &format);
+
+	// Finds the vertices of the quadrilateral formed by the face and its matched neighbor, returns the shared half-edge of the face
+	static unsigned int findQuadVertices(const TriangularMesh* mesh, unsigned int face, unsigned int pair, unsigned int vertices[4]);
+
+	// Writes a single polygon with the given corner points as an OFF file
+	static bool writePolygon(std::string filepath, const Vertex* points, unsigned int pointCount);
+
+	// Pads the file with zeros up to the offset and writes the block, the position is advanced past the block
+	static bool writeBlock(FILE* outfile, const void* data, size_t size, uint64_t offset, uint64_t &position);
+
+	// Formats a vertex line and returns the end of the written characters
+	static char* formatVertex(char* position, const Vertex &vertex);
+
+	// Formats a quadrilateral line and returns the end of the written characters
+	static char* formatQuad(char* position, unsigned int a, unsigned int b, unsigned int c, unsigned int d);
+
 };
 
 #endif
@@ -0,0 +1,68 @@
+#include "MonotonicArena.h"
+#include <algorithm>
+#include <new>
+
+// Smallest block that is allocated when the reserved space runs out
+#define MINIMUM_BLOCK_SIZE (1 << 20)
+
+MonotonicArena::MonotonicArena() {
+	position = 0;
+	end = 0;
+	usedSize = 0;
+}
+
+MonotonicArena::~MonotonicArena() {
+	release();
+}
+
+void MonotonicArena::reserve(size_t size) {
+
+	// Keep the current block if it is large enough
+	size_t alignedSize = (size + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+	if ((size_t) (end - position) >= alignedSize) {
+		return;
+	}
+
+	// Allocate a block of exactly the requested size, the rest of the current block is given up
+	char* block = static_cast<char*>(::operator new(alignedSize, std::align_val_t(ALIGNMENT)));
+	blocks.push_back(block);
+	position = block;
+	end = block + alignedSize;
+}
+
+void MonotonicArena::release() {
+
+	// Delete every block
+	for (size_t i = 0; i < blocks.size(); i++) {
+		::operator delete(blocks[i], std::align_val_t(ALIGNMENT));
+	}
+	blocks.clear();
+	position = 0;
+	end = 0;
+	usedSize = 0;
+}
+
+size_t MonotonicArena::getUsedSize() const {
+	return usedSize;
+}
+
+size_t MonotonicArena::getBlockCount() const {
+	return blocks.size();
+}
+
+void* MonotonicArena::allocateBytes(size_t size) {
+
+	// Round the size up so that the next allocation stays aligned
+	size_t alignedSize = (size + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+
+	// Continue with a new block if the current one is full
+	if ((size_t) (end - position) < alignedSize) {
+		reserve(std::max<size_t>(alignedSize, MINIMUM_BLOCK_SIZE));
+	}
+
+	// Hand out the start of the free part
+	void* memory = position;
+	position += alignedSize;
+	usedSize += alignedSize;
+	return memory;
+}
@@ -0,0 +1,60 @@
+#ifndef MONOTONIC_ARENA
+#define MONOTONIC_ARENA
+
+#include <vector>
+#include <cstddef>
+
+// Hands out memory from large blocks and releases everything at once
+// Memory is never returned to the arena individually and no destructors are run
+class MonotonicArena {
+public:
+
+	// Alignment of every allocation in bytes
+	const static size_t ALIGNMENT = 64;
+
+	// Constructor
+	MonotonicArena();
+
+	// Destructor, releases every block
+	~MonotonicArena();
+
+	// Makes sure that the given number of bytes can be allocated without a new block
+	void reserve(size_t size);
+
+	// Allocates uninitialized memory for the given number of elements
+	template <typename T>
+	T* allocate(size_t count) {
+		return static_cast<T*>(allocateBytes(count * sizeof(T)));
+	}
+
+	// Releases every block
+	void release();
+
+	// Returns the number of bytes handed out since the last release
+	size_t getUsedSize() const;
+
+	// Returns the number of blocks allocated since the last release
+	size_t getBlockCount() const;
+
+private:
+
+	// Allocated blocks
+	std::vector<char*> blocks;
+
+	// Free part of the current block
+	char* position;
+	char* end;
+
+	// Number of bytes handed out
+	size_t usedSize;
+
+	// Allocates aligned memory, a new block is allocated if the current one is full
+	void* allocateBytes(size_t size);
+
+	// Arenas own their blocks and cannot be shared between owners
+	MonotonicArena(const MonotonicArena&);
+	MonotonicArena& operator=(const MonotonicArena&);
+
+};
+
+#endif
@@ -0,0 +1,193 @@
+#include "OffParser.h"
+#include <charconv>
+#include <cstring>
+#include <cctype>
+
+OffParser::OffParser(const char* begin, const char* end, size_t line) {
+	this->position = begin;
+	this->end = end;
+	this->line = line;
+}
+
+bool OffParser::readHeader(unsigned int &numVertices, unsigned int &numFaces) {
+
+	// Read the file format keyword, the variants with colors or normals also end with OFF
+	if (!skipBlank()) {
+		return fail("missing OFF header");
+	}
+	const char* keyword = position;
+	while (position < end && !isspace((unsigned char) *position) && *position != '#') {
+		position++;
+	}
+	size_t length = position - keyword;
+	if (length < 3 || strncmp(position - 3, "OFF", 3) != 0) {
+		return fail("missing OFF header");
+	}
+
+	// Read the vertex and face counts, they may also be on the keyword line
+	unsigned int numEdges;
+	if (!skipBlank() || !readUnsigned(numVertices) || !readUnsigned(numFaces)) {
+		return fail("expected vertex and face counts");
+	}
+
+	// The edge count is optional and not used
+	skipInlineBlank();
+	if (position < end && *position != '\n' && !readUnsigned(numEdges)) {
+		return fail("invalid edge count");
+	}
+	skipLine();
+	return true;
+}
+
+bool OffParser::readVertex(Vertex &vertex) {
+
+	// Find the line of the vertex
+	if (!skipBlank()) {
+		return fail("unexpected end of file, expected a vertex");
+	}
+
+	// Read the coordinates of the vertex
+	if (!readFloat(vertex.x) || !readFloat(vertex.y) || !readFloat(vertex.z)) {
+		return fail("expected three vertex coordinates");
+	}
+
+	// Skip optional colors and texture coordinates
+	skipLine();
+	return true;
+}
+
+bool OffParser::readFace(std::vector<Face> &faces, unsigned int numVertices) {
+
+	// Find the line of the face
+	if (!skipBlank()) {
+		return fail("unexpected end of file, expected a face");
+	}
+
+	// Read the number of vertices of the face
+	unsigned int vertexCount;
+	if (!readUnsigned(vertexCount)) {
+		return fail("expected the vertex count of a face");
+	}
+	if (vertexCount < 3) {
+		return fail("face with " + std::to_string(vertexCount) + " vertices");
+	}
+
+	// Read the vertex indices and split polygons into a triangle fan around the first vertex
+	unsigned int first, previous, current;
+	for (unsigned int i = 0; i < vertexCount; i++) {
+		if (!readUnsigned(current)) {
+			return fail("expected " + std::to_string(vertexCount) + " vertex indices");
+		}
+		if (current >= numVertices) {
+			return fail("vertex index " + std::to_string(current) + " out of range");
+		}
+		if (i == 0) {
+			first = current;
+		} else if (i >= 2) {
+			faces.push_back(Face(first, previous, current));
+		}
+		previous = current;
+	}
+
+	// Skip optional face colors
+	skipLine();
+	return true;
+}
+
+bool OffParser::skipBlank() {
+
+	// Skip whitespace and comments across lines
+	while (position < end) {
+		char c = *position;
+		if (c == '\n') {
+			line++;
+			position++;
+		} else if (c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f') {
+			position++;
+		} else if (c == '#') {
+			while (position < end && *position != '\n') {
+				position++;
+			}
+		} else {
+			return true;
+		}
+	}
+
+	// The end is reached
+	return false;
+}
+
+const char* OffParser::getPosition() const {
+	return position;
+}
+
+size_t OffParser::getLine() const {
+	return line;
+}
+
+const std::string& OffParser::getError() const {
+	return error;
+}
+
+void OffParser::skipInlineBlank() {
+
+	// Skip spaces on the line, a comment runs until the line break
+	while (position < end) {
+		char c = *position;
+		if (c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f') {
+			position++;
+		} else if (c == '#') {
+			while (position < end && *position != '\n') {
+				position++;
+			}
+		} else {
+			return;
+		}
+	}
+}
+
+void OffParser::skipLine() {
+
+	// Jump to the next line break and step over it
+	const char* lineBreak = (const char*) memchr(position, '\n', end - position);
+	if (lineBreak == 0) {
+		position = end;
+	} else {
+		position = lineBreak + 1;
+		line++;
+	}
+}
+
+bool OffParser::readFloat(float &value) {
+
+	// Parse the number in place, from_chars does not accept a leading plus sign
+	skipInlineBlank();
+	if (position < end && *position == '+') {
+		position++;
+	}
+	std::from_chars_result result = std::from_chars(position, end, value);
+	if (result.ec != std::errc()) {
+		return false;
+	}
+	position = result.ptr;
+	return true;
+}
+
+bool OffParser::readUnsigned(unsigned int &value) {
+
+	// Parse the number in place
+	skipInlineBlank();
+	std::from_chars_result result = std::from_chars(position, end, value);
+	if (result.ec != std::errc()) {
+		return false;
+	}
+	position = result.ptr;
+	return true;
+}
+
+bool OffParser::fail(const std::string &message) {
+
+	// Keep the line number together with the message
+	error = "line " + std::to_string(line) + ": " + message;
+	return false;
+}
@@ -0,0 +1,65 @@
+#ifndef OFF_PARSER
+#define OFF_PARSER
+
+#include "Face.h"
+#include <vector>
+#include <string>
+#include <cstddef>
+
+class OffParser {
+public:
+
+	// Constructor, parses the characters in [begin, end) starting from the given line number
+	OffParser(const char* begin, const char* end, size_t line = 1);
+
+	// Reads the OFF keyword and the vertex and face counts
+	bool readHeader(unsigned int &numVertices, unsigned int &numFaces);
+
+	// Reads the next vertex record, anything after the coordinates on the same line is ignored
+	bool readVertex(Vertex &vertex);
+
+	// Reads the next face record and appends it to the list as a triangle fan
+	bool readFace(std::vector<Face> &faces, unsigned int numVertices);
+
+	// Skips whitespace, blank lines and comments, returns false if the end is reached
+	bool skipBlank();
+
+	// Returns the current position
+	const char* getPosition() const;
+
+	// Returns the current line number
+	size_t getLine() const;
+
+	// Returns the message of the last error together with its line number
+	const std::string& getError() const;
+
+private:
+
+	// Current position and the end of the parsed characters
+	const char* position;
+	const char* end;
+
+	// Line number of the current position
+	size_t line;
+
+	// Message of the last error
+	std::string error;
+
+	// Skips spaces and comments without leaving the current line
+	void skipInlineBlank();
+
+	// Skips the rest of the current line including the line break
+	void skipLine();
+
+	// Reads a floating point number on the current line
+	bool readFloat(float &value);
+
+	// Reads an unsigned integer on the current line
+	bool readUnsigned(unsigned int &value);
+
+	// Stores an error message for the current line and returns false
+	bool fail(const std::string &message);
+
+};
+
+#endif
@@ -0,0 +1,328 @@
+#include "OptimalMatching.h"
+#include <algorithm>
+#include <chrono>
+
+OptimalMatching::OptimalMatching(const TriangularMesh* mesh, EdgeMetricCache* metricCache, QueueType queueType) : MatchingEngine(mesh, metricCache) {
+	greedyEngine = new GreedyMatching(mesh, metricCache, queueType);
+	size_t faceCount = mesh->getFaceCount();
+	partners.assign(faceCount, INVALID_INDEX);
+	threshold = 360;
+	predecessors.assign(faceCount, INVALID_INDEX);
+	bases.resize(faceCount);
+	for (size_t face = 0; face < faceCount; face++) {
+		bases[face] = (unsigned int) face;
+	}
+	evenFlags.assign(faceCount, 0);
+	ancestorMarks.assign(faceCount, 0);
+	ancestorStamp = 0;
+	removedMarks.assign(faceCount, 0);
+	removedStamp = 0;
+	greedyPairCount = 0;
+	greedyMaximumWarpage = 0;
+	greedyTotalWarpage = 0;
+	maximumWarpage = 0;
+	totalWarpage = 0;
+	infeasibleThreshold = 0;
+	thresholdIterationCount = 0;
+	augmentationCount = 0;
+	failedSearchCount = 0;
+	blossomCount = 0;
+	warmStartSeconds = 0;
+	searchSeconds = 0;
+}
+
+OptimalMatching::~OptimalMatching() {
+	delete greedyEngine;
+	greedyEngine = 0;
+}
+
+void OptimalMatching::initialize() {
+	greedyEngine->initialize();
+}
+
+void OptimalMatching::calculateMatching(std::map<unsigned int, unsigned int> &matching, std::vector<unsigned int> &unmatchedFaces) {
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	// Take the greedy matching as the warm start
+	std::map<unsigned int, unsigned int> greedyMatching;
+	std::vector<unsigned int> greedyUnmatchedFaces;
+	greedyEngine->calculateMatching(greedyMatching, greedyUnmatchedFaces);
+	for (std::map<unsigned int, unsigned int>::const_iterator it = greedyMatching.begin(); it != greedyMatching.end(); ++it) {
+		partners[it->first] = it->second;
+		partners[it->second] = it->first;
+	}
+	greedyPairCount = greedyMatching.size();
+	measureMatching(partners, greedyMaximumWarpage, greedyTotalWarpage);
+	std::chrono::steady_clock::time_point searchStart = std::chrono::steady_clock::now();
+	warmStartSeconds = std::chrono::duration<double>(searchStart - start).count();
+
+	// Grow the warm start into a maximum matching using every valid edge
+	size_t faceCount = mesh->getFaceCount();
+	threshold = 360;
+	augmentMatching(faceCount);
+	size_t pairCount = 0;
+	for (size_t face = 0; face < faceCount; face++) {
+		pairCount += partners[face] != INVALID_INDEX;
+	}
+	pairCount /= 2;
+	size_t allowedFailureCount = faceCount - 2 * pairCount;
+
+	// Collect the distinct values of the valid edges, the threshold is searched among them
+	std::vector<double> values;
+	for (unsigned int halfEdge = 0; halfEdge < faceCount * 3; halfEdge++) {
+		unsigned int twin = mesh->getTwin(halfEdge);
+		if (twin != INVALID_INDEX && halfEdge < twin && metricCache->getStoredMaximumWarpage(halfEdge) < 360) {
+			values.push_back(metricCache->getStoredMaximumWarpage(halfEdge));
+		}
+	}
+	std::sort(values.begin(), values.end());
+	values.erase(std::unique(values.begin(), values.end()), values.end());
+
+	// Binary search the smallest threshold that keeps the matching maximum, the best matching so far is the start of every search
+	std::vector<unsigned int> bestPartners = partners;
+	double total = 0;
+	measureMatching(bestPartners, maximumWarpage, total);
+	size_t low = 0;
+	size_t high = std::lower_bound(values.begin(), values.end(), maximumWarpage) - values.begin();
+	while (low < high) {
+		thresholdIterationCount++;
+		size_t middle = (low + high) / 2;
+		threshold = values[middle];
+
+		// Free the pairs above the threshold
+		partners = bestPartners;
+		for (size_t face = 0; face < faceCount; face++) {
+			unsigned int partner = partners[face];
+			if (partner != INVALID_INDEX && face < partner && !isUsable(mesh->findSharedHalfEdge((unsigned int) face, partner))) {
+				partners[face] = INVALID_INDEX;
+				partners[partner] = INVALID_INDEX;
+			}
+		}
+
+		// Keep the matching if it is still maximum, the largest value of the new matching can be below the threshold
+		if (augmentMatching(allowedFailureCount)) {
+			bestPartners = partners;
+			measureMatching(bestPartners, maximumWarpage, total);
+			high = std::lower_bound(values.begin(), values.end(), maximumWarpage) - values.begin();
+		} else {
+			low = middle + 1;
+		}
+	}
+
+	// Grow the greedy pairs under the optimal threshold into the final matching, which keeps more of the low warpage pairs
+	// The size of a maximum matching under a threshold does not depend on the start, so this cannot fail
+	threshold = values.empty() ? 0 : values[high];
+	partners.assign(faceCount, INVALID_INDEX);
+	for (std::map<unsigned int, unsigned int>::const_iterator it = greedyMatching.begin(); it != greedyMatching.end(); ++it) {
+		if (isUsable(mesh->findSharedHalfEdge(it->first, it->second))) {
+			partners[it->first] = it->second;
+			partners[it->second] = it->first;
+		}
+	}
+	if (!augmentMatching(allowedFailureCount)) {
+		partners = bestPartners;
+	}
+	measureMatching(partners, maximumWarpage, totalWarpage);
+	infeasibleThreshold = high > 0 ? values[high - 1] : 0;
+	searchSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - searchStart).count();
+
+	// Add the pairs under their smaller face and the faces left alone in increasing order
+	collectMatching(partners, matching, unmatchedFaces);
+}
+
+void OptimalMatching::addStatistics(std::map<std::string, double> &statistics) const {
+	statistics["greedyPairCount"] = (double) greedyPairCount;
+	statistics["greedyMaximumWarpage"] = greedyMaximumWarpage;
+	statistics["greedyMeanWarpage"] = greedyPairCount > 0 ? greedyTotalWarpage / greedyPairCount : 0;
+	statistics["maximumWarpage"] = maximumWarpage;
+	statistics["maximumWarpageLowerBound"] = infeasibleThreshold;
+	size_t pairCount = 0;
+	for (size_t face = 0; face < partners.size(); face++) {
+		pairCount += partners[face] != INVALID_INDEX;
+	}
+	pairCount /= 2;
+	statistics["meanWarpage"] = pairCount > 0 ? totalWarpage / pairCount : 0;
+	statistics["thresholdIterationCount"] = (double) thresholdIterationCount;
+	statistics["augmentationCount"] = (double) augmentationCount;
+	statistics["failedSearchCount"] = (double) failedSearchCount;
+	statistics["blossomCount"] = (double) blossomCount;
+	statistics["warmStartSeconds"] = warmStartSeconds;
+	statistics["searchSeconds"] = searchSeconds;
+}
+
+bool OptimalMatching::augmentMatching(size_t allowedFailureCount) {
+
+	// Faces removed by the searches of an earlier threshold are usable again
+	removedStamp++;
+	size_t failureCount = 0;
+	for (unsigned int face = 0; face < partners.size(); face++) {
+		if (partners[face] != INVALID_INDEX || removedMarks[face] == removedStamp) {
+			continue;
+		}
+
+		// Flip the path if there is one, otherwise no later augmentation reaches the faces of the tree and they are removed
+		unsigned int end = findAugmentingPath(face);
+		if (end != INVALID_INDEX) {
+			augmentPath(end);
+			augmentationCount++;
+		} else {
+			for (size_t i = 0; i < touchedFaces.size(); i++) {
+				removedMarks[touchedFaces[i]] = removedStamp;
+			}
+			failedSearchCount++;
+			failureCount++;
+		}
+		resetSearch();
+
+		// Every failed root stays free, so the matching cannot be maximum anymore
+		if (failureCount > allowedFailureCount) {
+			return false;
+		}
+	}
+	return true;
+}
+
+unsigned int OptimalMatching::findAugmentingPath(unsigned int root) {
+
+	// Start the tree at the free face
+	evenFlags[root] = 1;
+	touchedFaces.push_back(root);
+	searchQueue.clear();
+	searchQueue.push_back(root);
+	for (size_t i = 0; i < searchQueue.size(); i++) {
+		unsigned int face = searchQueue[i];
+		for (unsigned int halfEdge = face * 3; halfEdge < face * 3 + 3; halfEdge++) {
+
+			// Skip boundaries, unusable edges, removed faces, edges inside a blossom and the matched edge
+			unsigned int twin = mesh->getTwin(halfEdge);
+			if (twin == INVALID_INDEX || !isUsable(halfEdge)) {
+				continue;
+			}
+			unsigned int neighbor = twin / 3;
+			if (removedMarks[neighbor] == removedStamp || findBase(face) == findBase(neighbor) || partners[face] == neighbor) {
+				continue;
+			}
+
+			// An even neighbor closes an odd cycle, contract it into a blossom whose faces are all even
+			if (neighbor == root || (partners[neighbor] != INVALID_INDEX && predecessors[partners[neighbor]] != INVALID_INDEX)) {
+				unsigned int base = findCommonBase(face, neighbor);
+				blossomBases.clear();
+				markBlossomPath(face, base, neighbor);
+				markBlossomPath(neighbor, base, face);
+				for (size_t j = 0; j < blossomBases.size(); j++) {
+					if (blossomBases[j] != base) {
+						bases[blossomBases[j]] = base;
+					}
+				}
+				blossomCount++;
+			} else if (predecessors[neighbor] == INVALID_INDEX) {
+
+				// A free neighbor ends an augmenting path, a matched one becomes odd and its partner even
+				predecessors[neighbor] = face;
+				touchedFaces.push_back(neighbor);
+				if (partners[neighbor] == INVALID_INDEX) {
+					return neighbor;
+				}
+				unsigned int partner = partners[neighbor];
+				evenFlags[partner] = 1;
+				touchedFaces.push_back(partner);
+				searchQueue.push_back(partner);
+			}
+		}
+	}
+	return INVALID_INDEX;
+}
+
+unsigned int OptimalMatching::findBase(unsigned int face) {
+
+	// Find the root and compress the path to it
+	unsigned int root = face;
+	while (bases[root] != root) {
+		root = bases[root];
+	}
+	while (bases[face] != root) {
+		unsigned int next = bases[face];
+		bases[face] = root;
+		face = next;
+	}
+	return root;
+}
+
+unsigned int OptimalMatching::findCommonBase(unsigned int first, unsigned int second) {
+
+	// Mark the bases on the way from the first face up to the root
+	ancestorStamp++;
+	while (true) {
+		first = findBase(first);
+		ancestorMarks[first] = ancestorStamp;
+		if (partners[first] == INVALID_INDEX) {
+			break;
+		}
+		first = predecessors[partners[first]];
+	}
+
+	// The first marked base on the way up from the second face is the common one
+	while (true) {
+		second = findBase(second);
+		if (ancestorMarks[second] == ancestorStamp) {
+			return second;
+		}
+		second = predecessors[partners[second]];
+	}
+}
+
+void OptimalMatching::markBlossomPath(unsigned int face, unsigned int base, unsigned int child) {
+	while (findBase(face) != base) {
+
+		// The odd faces on the path become even and are scanned later
+		unsigned int partner = partners[face];
+		blossomBases.push_back(findBase(face));
+		blossomBases.push_back(findBase(partner));
+		if (!evenFlags[partner]) {
+			evenFlags[partner] = 1;
+			touchedFaces.push_back(partner);
+			searchQueue.push_back(partner);
+		}
+
+		// Point the face at the other side of the cycle so the augmenting path can go around the blossom
+		predecessors[face] = child;
+		child = partner;
+		face = predecessors[partner];
+	}
+}
+
+void OptimalMatching::augmentPath(unsigned int end) {
+
+	// Swap the matched and the unmatched edges from the end back to the root
+	unsigned int face = end;
+	while (face != INVALID_INDEX) {
+		unsigned int predecessor = predecessors[face];
+		unsigned int next = partners[predecessor];
+		partners[face] = predecessor;
+		partners[predecessor] = face;
+		face = next;
+	}
+}
+
+void OptimalMatching::resetSearch() {
+	for (size_t i = 0; i < touchedFaces.size(); i++) {
+		unsigned int face = touchedFaces[i];
+		predecessors[face] = INVALID_INDEX;
+		bases[face] = face;
+		evenFlags[face] = 0;
+	}
+	touchedFaces.clear();
+}
+
+void OptimalMatching::measureMatching(const std::vector<unsigned int> &matching, double &maximum, double &total) const {
+	maximum = 0;
+	total = 0;
+	for (size_t face = 0; face < matching.size(); face++) {
+		unsigned int partner = matching[face];
+		if (partner != INVALID_INDEX && face < partner) {
+			double value = metricCache->getStoredMaximumWarpage(mesh->findSharedHalfEdge((unsigned int) face, partner));
+			maximum = std::max(maximum, value);
+			total += value;
+		}
+	}
+}
@@ -0,0 +1,97 @@
+#ifndef OPTIMAL_MATCHING
+#define OPTIMAL_MATCHING
+
+#include "MatchingEngine.h"
+#include "GreedyMatching.h"
+
+// Exact matching that pairs as many faces as possible and among those matchings minimizes the largest warpage
+// The greedy result is grown into a maximum matching with the blossom algorithm on the sparse face adjacency
+// A binary search over the edge values then finds the smallest threshold that still allows a matching of that size
+// The search below the result fails, which proves that no matching of the same size has a smaller maximum warpage
+class OptimalMatching : public MatchingEngine {
+public:
+
+	// Constructor, the greedy warm start orders the faces with a queue of the given type
+	OptimalMatching(const TriangularMesh* mesh, EdgeMetricCache* metricCache, QueueType queueType);
+
+	// Destructor
+	~OptimalMatching();
+
+	void initialize();
+	void calculateMatching(std::map<unsigned int, unsigned int> &matching, std::vector<unsigned int> &unmatchedFaces);
+	void addStatistics(std::map<std::string, double> &statistics) const;
+
+private:
+
+	// Engine of the warm start
+	GreedyMatching* greedyEngine;
+
+	// Matched neighbor of every face, INVALID_INDEX while the face is free
+	std::vector<unsigned int> partners;
+
+	// Largest usable edge value, edges above it are left out of the searches
+	double threshold;
+
+	// Search state of the blossom algorithm, reset only on the touched faces after every search
+	// The predecessor of an odd face is the even face it was reached from, the bases form a union-find forest of the blossoms
+	std::vector<unsigned int> predecessors;
+	std::vector<unsigned int> bases;
+	std::vector<unsigned char> evenFlags;
+	std::vector<unsigned int> touchedFaces;
+	std::vector<unsigned int> searchQueue;
+	std::vector<unsigned int> blossomBases;
+
+	// Marks of the common base search and of the faces removed with a failed search, compared with a running stamp
+	std::vector<size_t> ancestorMarks;
+	size_t ancestorStamp;
+	std::vector<size_t> removedMarks;
+	size_t removedStamp;
+
+	// Statistics of the warm start and the searches
+	size_t greedyPairCount;
+	double greedyMaximumWarpage;
+	double greedyTotalWarpage;
+	double maximumWarpage;
+	double totalWarpage;
+	double infeasibleThreshold;
+	size_t thresholdIterationCount;
+	size_t augmentationCount;
+	size_t failedSearchCount;
+	size_t blossomCount;
+	double warmStartSeconds;
+	double searchSeconds;
+
+	// Returns true if the quadrilateral on the edge of the half-edge can be used under the current threshold
+	bool isUsable(unsigned int halfEdge) const {
+		double value = metricCache->getStoredMaximumWarpage(halfEdge);
+		return value < 360 && value <= threshold;
+	}
+
+	// Augments from every free face under the current threshold, the faces of a failed search stay free for good
+	// Returns false as soon as more searches fail than allowed
+	bool augmentMatching(size_t allowedFailureCount);
+
+	// Grows an alternating tree from the free face, returns the free face at the end of an augmenting path or INVALID_INDEX
+	unsigned int findAugmentingPath(unsigned int root);
+
+	// Returns the base of the blossom that contains the face
+	unsigned int findBase(unsigned int face);
+
+	// Returns the base of the innermost blossom on the tree paths of both even faces
+	unsigned int findCommonBase(unsigned int first, unsigned int second);
+
+	// Links the faces on the tree path from the face up to the base around the new blossom and collects the bases on it
+	void markBlossomPath(unsigned int face, unsigned int base, unsigned int child);
+
+	// Flips the matching along the path that ends at the free face
+	void augmentPath(unsigned int end);
+
+	// Clears the search state of the touched faces
+	void resetSearch();
+
+	// Returns the largest and the total warpage of the matched pairs
+	void measureMatching(const std::vector<unsigned int> &matching, double &maximum, double &total) const;
+
+};
+
+#endif
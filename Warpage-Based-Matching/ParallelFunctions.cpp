@@ -0,0 +1,62 @@
+#include "ParallelFunctions.h"
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+unsigned int ParallelFunctions::threadCount = 0;
+
+unsigned int ParallelFunctions::getThreadCount() {
+
+	// Use every hardware thread unless another count is set
+	if (threadCount == 0) {
+		setThreadCount(0);
+	}
+
+	// Return the number of worker threads
+	return threadCount;
+}
+
+void ParallelFunctions::setThreadCount(unsigned int count) {
+
+	// Fall back to a single thread if the hardware concurrency is unknown
+	if (count == 0) {
+		count = std::max(1u, std::thread::hardware_concurrency());
+	}
+
+	// Store the number of worker threads
+	threadCount = count;
+}
+
+void ParallelFunctions::parallelFor(size_t begin, size_t end, const std::function<void(size_t, size_t, unsigned int)> &body, size_t grain) {
+
+	// Nothing to do for empty ranges
+	if (end <= begin) {
+		return;
+	}
+
+	// Use no more ranges than the grain allows
+	size_t count = end - begin;
+	size_t rangeCount = std::min<size_t>(getThreadCount(), (count + grain - 1) / std::max<size_t>(grain, 1));
+	rangeCount = std::max<size_t>(rangeCount, 1);
+
+	// Run small inputs on the calling thread
+	if (rangeCount == 1) {
+		body(begin, end, 0);
+		return;
+	}
+
+	// Start a thread for every range except the first one, which runs on the calling thread
+	std::vector<std::thread> threads;
+	threads.reserve(rangeCount - 1);
+	for (size_t i = 1; i < rangeCount; i++) {
+		size_t rangeBegin = begin + count * i / rangeCount;
+		size_t rangeEnd = begin + count * (i + 1) / rangeCount;
+		threads.push_back(std::thread(std::cref(body), rangeBegin, rangeEnd, (unsigned int) i));
+	}
+	body(begin, begin + count / rangeCount, 0);
+
+	// Wait for every range to finish
+	for (size_t i = 0; i < threads.size(); i++) {
+		threads[i].join();
+	}
+}
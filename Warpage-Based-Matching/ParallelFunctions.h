@@ -0,0 +1,79 @@
+#ifndef PARALLEL_FUNCTIONS
+#define PARALLEL_FUNCTIONS
+
+#include <functional>
+#include <algorithm>
+#include <vector>
+#include <cstddef>
+
+class ParallelFunctions {
+public:
+
+	// Returns the number of worker threads used by the parallel algorithms
+	static unsigned int getThreadCount();
+
+	// Sets the number of worker threads, 0 selects the number of hardware threads
+	static void setThreadCount(unsigned int count);
+
+	// Splits [begin, end) into contiguous ranges and runs the body on each range on its own thread
+	// The body receives the range and the index of the range, ranges shorter than the grain are not split further
+	static void parallelFor(size_t begin, size_t end, const std::function<void(size_t, size_t, unsigned int)> &body, size_t grain = 1);
+
+	// Sorts the values with std::sort on contiguous ranges of every thread and merges neighboring ranges pairwise in parallel
+	// The order is the same for every thread count as long as the comparison is a strict total order
+	template <class T, class Compare>
+	static void parallelSort(std::vector<T> &values, Compare compare, size_t grain = 1) {
+
+		// Use no more ranges than the grain allows and sort small inputs on the calling thread
+		size_t count = values.size();
+		size_t rangeCount = std::min<size_t>(getThreadCount(), (count + grain - 1) / std::max<size_t>(grain, 1));
+		if (rangeCount <= 1) {
+			std::sort(values.begin(), values.end(), compare);
+			return;
+		}
+
+		// Sort every range on its own thread
+		std::vector<size_t> bounds(rangeCount + 1);
+		for (size_t i = 0; i <= rangeCount; i++) {
+			bounds[i] = count * i / rangeCount;
+		}
+		parallelFor(0, rangeCount, [&](size_t first, size_t last, unsigned int) {
+			for (size_t i = first; i < last; i++) {
+				std::sort(values.begin() + bounds[i], values.begin() + bounds[i + 1], compare);
+			}
+		});
+
+		// Merge the ranges in pairs into the buffer until one range is left, an odd last range is copied
+		std::vector<T> buffer(count);
+		while (bounds.size() > 2) {
+			size_t ranges = bounds.size() - 1;
+			parallelFor(0, (ranges + 1) / 2, [&](size_t first, size_t last, unsigned int) {
+				for (size_t i = first; i < last; i++) {
+					size_t begin = bounds[2 * i];
+					if (2 * i + 1 < ranges) {
+						std::merge(values.begin() + begin, values.begin() + bounds[2 * i + 1], values.begin() + bounds[2 * i + 1], values.begin() + bounds[2 * i + 2], buffer.begin() + begin, compare);
+					} else {
+						std::copy(values.begin() + begin, values.begin() + bounds[2 * i + 1], buffer.begin() + begin);
+					}
+				}
+			});
+			values.swap(buffer);
+
+			// Keep the bounds of the merged ranges
+			std::vector<size_t> mergedBounds;
+			for (size_t i = 0; i < ranges; i += 2) {
+				mergedBounds.push_back(bounds[i]);
+			}
+			mergedBounds.push_back(count);
+			bounds.swap(mergedBounds);
+		}
+	}
+
+private:
+
+	// Number of worker threads, 0 until it is first set or queried
+	static unsigned int threadCount;
+
+};
+
+#endif
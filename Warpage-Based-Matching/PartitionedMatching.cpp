@@ -0,0 +1,205 @@
+#include "PartitionedMatching.h"
+#include "GreedyMatching.h"
+#include "ParallelFunctions.h"
+#include <algorithm>
+#include <chrono>
+
+// Number of bits of a centroid coordinate in the Morton code
+#define MORTON_BITS 10
+
+// Smallest number of faces handed to a thread while the Morton codes are calculated
+#define MINIMUM_MORTON_RANGE 4096
+
+// Smallest number of Morton keys sorted by a thread
+#define MINIMUM_SORT_RANGE 65536
+
+// Spreads the lowest 10 bits of the value so that two zero bits follow every bit
+static uint64_t spreadBits(uint64_t value) {
+	value &= 0x3FF;
+	value = (value | (value << 16)) & 0x30000FF;
+	value = (value | (value << 8)) & 0x300F00F;
+	value = (value | (value << 4)) & 0x30C30C3;
+	value = (value | (value << 2)) & 0x9249249;
+	return value;
+}
+
+PartitionedMatching::PartitionedMatching(const TriangularMesh* mesh, EdgeMetricCache* metricCache, QueueType queueType) : MatchingEngine(mesh, metricCache) {
+	this->queueType = queueType;
+	partners.assign(mesh->getFaceCount(), INVALID_INDEX);
+	partitionCount = 0;
+	cutEdgeCount = 0;
+	borderFaceCount = 0;
+	borderUnmatchedFaceCount = 0;
+	reconciledPairCount = 0;
+	borderMatchLoss = 0;
+}
+
+void PartitionedMatching::initialize() {
+
+	// Find the bounding box of the vertices
+	size_t faceCount = mesh->getFaceCount();
+	size_t vertexCount = mesh->getVertexCount();
+	Vertex minimum(0, 0, 0);
+	Vertex maximum(0, 0, 0);
+	for (size_t vertex = 0; vertex < vertexCount; vertex++) {
+		const Vertex &coordinate = mesh->getCoordinate((unsigned int) vertex);
+		if (vertex == 0) {
+			minimum = coordinate;
+			maximum = coordinate;
+		}
+		minimum = Vertex(std::min(minimum.x, coordinate.x), std::min(minimum.y, coordinate.y), std::min(minimum.z, coordinate.z));
+		maximum = Vertex(std::max(maximum.x, coordinate.x), std::max(maximum.y, coordinate.y), std::max(maximum.z, coordinate.z));
+	}
+	const Vertex extent = maximum - minimum;
+
+	// Calculate the Morton codes on every thread, the face index in the lower bits makes every key unique
+	std::vector<uint64_t> keys(faceCount);
+	ParallelFunctions::parallelFor(0, faceCount, [&](size_t first, size_t last, unsigned int) {
+		for (size_t face = first; face < last; face++) {
+			keys[face] = (calculateMortonCode((unsigned int) face, minimum, extent) << 32) | face;
+		}
+	}, MINIMUM_MORTON_RANGE);
+
+	// Sort the faces on their keys and store the order on every thread, the keys are unique so the order is the same for every thread count
+	ParallelFunctions::parallelSort(keys, std::less<uint64_t>(), MINIMUM_SORT_RANGE);
+	sortedFaces.resize(faceCount);
+	sortedPositions.resize(faceCount);
+	ParallelFunctions::parallelFor(0, faceCount, [&](size_t first, size_t last, unsigned int) {
+		for (size_t position = first; position < last; position++) {
+			unsigned int face = (unsigned int) keys[position];
+			sortedFaces[position] = face;
+			sortedPositions[face] = (unsigned int) position;
+		}
+	}, MINIMUM_MORTON_RANGE);
+
+	// Cut the sorted faces into partitions
+	partitionCount = (faceCount + PARTITION_SIZE - 1) / PARTITION_SIZE;
+	partitionSeconds.assign(partitionCount, 0.0);
+}
+
+void PartitionedMatching::calculateMatching(std::map<unsigned int, unsigned int> &matching, std::vector<unsigned int> &unmatchedFaces) {
+
+	// Match the partitions on every thread, a partition writes the partners of its own faces only
+	ParallelFunctions::parallelFor(0, partitionCount, [this](size_t first, size_t last, unsigned int) {
+		for (size_t partition = first; partition < last; partition++) {
+			std::chrono::steady_clock::time_point beginTime = std::chrono::steady_clock::now();
+			matchPartition((unsigned int) partition);
+			partitionSeconds[partition] = std::chrono::duration<double>(std::chrono::steady_clock::now() - beginTime).count();
+		}
+	});
+
+	// Pair the faces left free along the cuts
+	reconcileBorders();
+
+	// Add the pairs under their smaller face and the faces left alone in increasing order
+	collectMatching(partners, matching, unmatchedFaces);
+}
+
+void PartitionedMatching::addStatistics(std::map<std::string, double> &statistics) const {
+
+	// Summarize the time spent on the partitions
+	double totalSeconds = 0;
+	double minimumSeconds = partitionCount > 0 ? partitionSeconds[0] : 0;
+	double maximumSeconds = 0;
+	for (size_t partition = 0; partition < partitionCount; partition++) {
+		totalSeconds += partitionSeconds[partition];
+		minimumSeconds = std::min(minimumSeconds, partitionSeconds[partition]);
+		maximumSeconds = std::max(maximumSeconds, partitionSeconds[partition]);
+	}
+
+	// Store the partition and border statistics
+	statistics["partitionCount"] = (double) partitionCount;
+	statistics["partitionMinimumSeconds"] = minimumSeconds;
+	statistics["partitionMaximumSeconds"] = maximumSeconds;
+	statistics["partitionMeanSeconds"] = partitionCount > 0 ? totalSeconds / partitionCount : 0;
+	statistics["cutEdgeCount"] = (double) cutEdgeCount;
+	statistics["borderFaceCount"] = (double) borderFaceCount;
+	statistics["borderUnmatchedFaceCount"] = (double) borderUnmatchedFaceCount;
+	statistics["reconciledPairCount"] = (double) reconciledPairCount;
+	statistics["borderMatchLoss"] = (double) borderMatchLoss;
+}
+
+const std::vector<double>& PartitionedMatching::getPartitionSeconds() const {
+	return partitionSeconds;
+}
+
+uint64_t PartitionedMatching::calculateMortonCode(unsigned int face, const Vertex &minimum, const Vertex &extent) const {
+
+	// Find the centroid of the face
+	unsigned int halfEdge = TriangularMesh::getHalfEdge(face);
+	const Vertex centroid = (mesh->getCoordinate(mesh->getOrigin(halfEdge)) + mesh->getCoordinate(mesh->getOrigin(halfEdge + 1)) + mesh->getCoordinate(mesh->getOrigin(halfEdge + 2))) / 3;
+
+	// Quantize the centroid in the bounding box, flat axes map to zero
+	const float scale = (float) ((1 << MORTON_BITS) - 1);
+	uint64_t x = extent.x > 0 ? (uint64_t) (std::min(std::max((centroid.x - minimum.x) / extent.x, 0.0f), 1.0f) * scale) : 0;
+	uint64_t y = extent.y > 0 ? (uint64_t) (std::min(std::max((centroid.y - minimum.y) / extent.y, 0.0f), 1.0f) * scale) : 0;
+	uint64_t z = extent.z > 0 ? (uint64_t) (std::min(std::max((centroid.z - minimum.z) / extent.z, 0.0f), 1.0f) * scale) : 0;
+
+	// Interleave the bits of the axes
+	return spreadBits(x) | (spreadBits(y) << 1) | (spreadBits(z) << 2);
+}
+
+void PartitionedMatching::matchPartition(unsigned int partition) {
+
+	// Match the faces of the partition on their own engine, it writes the partners of the partition's faces only
+	size_t begin = (size_t) partition * PARTITION_SIZE;
+	size_t end = std::min<size_t>(begin + PARTITION_SIZE, sortedFaces.size());
+	GreedyMatching engine(mesh, metricCache, queueType, sortedFaces, sortedPositions, begin, end);
+	engine.initialize();
+	engine.calculatePartners(partners);
+}
+
+void PartitionedMatching::reconcileBorders() {
+
+	// Collect the cut edges and the faces on them, every edge once through its smaller half-edge
+	std::vector<unsigned char> borderFlags(mesh->getFaceCount(), 0);
+	std::vector<std::pair<double, unsigned int> > candidates;
+	size_t halfEdgeCount = mesh->getHalfEdgeCount();
+	for (size_t halfEdge = 0; halfEdge < halfEdgeCount; halfEdge++) {
+		unsigned int twin = mesh->getTwin((unsigned int) halfEdge);
+		if (twin == INVALID_INDEX || twin < halfEdge) {
+			continue;
+		}
+		unsigned int face = TriangularMesh::getFace((unsigned int) halfEdge);
+		unsigned int pair = TriangularMesh::getFace(twin);
+		if (getPartition(face) == getPartition(pair)) {
+			continue;
+		}
+		cutEdgeCount++;
+		borderFlags[face] = 1;
+		borderFlags[pair] = 1;
+
+		// Both faces must be free to form a quadrilateral on the edge
+		if (partners[face] == INVALID_INDEX && partners[pair] == INVALID_INDEX) {
+			double value = metricCache->getStoredMaximumWarpage((unsigned int) halfEdge);
+			if (value < 360) {
+				candidates.push_back(std::make_pair(value, (unsigned int) halfEdge));
+			}
+		}
+	}
+
+	// Count the border faces and the ones left free by the partitions
+	for (size_t face = 0; face < borderFlags.size(); face++) {
+		if (borderFlags[face]) {
+			borderFaceCount++;
+			if (partners[face] == INVALID_INDEX) {
+				borderUnmatchedFaceCount++;
+			}
+		}
+	}
+
+	// Accept the candidate edges in the order of their values while both faces are free, equal values in half-edge order
+	std::sort(candidates.begin(), candidates.end());
+	for (size_t i = 0; i < candidates.size(); i++) {
+		unsigned int face = TriangularMesh::getFace(candidates[i].second);
+		unsigned int pair = TriangularMesh::getFace(mesh->getTwin(candidates[i].second));
+		if (partners[face] == INVALID_INDEX && partners[pair] == INVALID_INDEX) {
+			partners[face] = pair;
+			partners[pair] = face;
+			reconciledPairCount++;
+		}
+	}
+
+	// The border faces that are still free are lost to the decomposition
+	borderMatchLoss = borderUnmatchedFaceCount - 2 * reconciledPairCount;
+}
@@ -0,0 +1,65 @@
+#ifndef PARTITIONED_MATCHING
+#define PARTITIONED_MATCHING
+
+#include "MatchingEngine.h"
+#include <cstdint>
+
+// Number of faces in a partition, the partition count depends only on the face count so the matching is the same for every thread count
+#define PARTITION_SIZE (1 << 18)
+
+// Spatial domain decomposition, the faces are sorted on the Morton codes of their centroids and cut into partitions of equal size
+// Every partition is matched greedily on its own thread considering only the edges inside it
+// A final pass pairs the faces that are left free on both sides of the edges between the partitions
+class PartitionedMatching : public MatchingEngine {
+public:
+
+	// Constructor, the faces of every partition are ordered with a queue of the given type
+	PartitionedMatching(const TriangularMesh* mesh, EdgeMetricCache* metricCache, QueueType queueType);
+
+	void initialize();
+	void calculateMatching(std::map<unsigned int, unsigned int> &matching, std::vector<unsigned int> &unmatchedFaces);
+	void addStatistics(std::map<std::string, double> &statistics) const;
+
+	// Wall-clock seconds spent on the matching of every partition
+	const std::vector<double>& getPartitionSeconds() const;
+
+private:
+
+	// Queue type of the partitions
+	QueueType queueType;
+
+	// Faces in Morton order, partition p holds the faces in [p * PARTITION_SIZE, (p + 1) * PARTITION_SIZE)
+	std::vector<unsigned int> sortedFaces;
+
+	// Position of every face in the sorted order
+	std::vector<unsigned int> sortedPositions;
+
+	// Matched neighbor of every face, INVALID_INDEX while the face is free
+	std::vector<unsigned int> partners;
+
+	// Statistics of the partitions and the reconciliation
+	size_t partitionCount;
+	std::vector<double> partitionSeconds;
+	size_t cutEdgeCount;
+	size_t borderFaceCount;
+	size_t borderUnmatchedFaceCount;
+	size_t reconciledPairCount;
+	size_t borderMatchLoss;
+
+	// Returns the partition of a face
+	unsigned int getPartition(unsigned int face) const {
+		return sortedPositions[face] / PARTITION_SIZE;
+	}
+
+	// Returns the Morton code of the centroid of the face in the bounding box, 10 bits on every axis
+	uint64_t calculateMortonCode(unsigned int face, const Vertex &minimum, const Vertex &extent) const;
+
+	// Matches the faces of the partition with a greedy engine considering only the neighbors in the same partition
+	void matchPartition(unsigned int partition);
+
+	// Pairs the free faces across the edges between the partitions in the order of their metric values
+	void reconcileBorders();
+
+};
+
+#endif
@@ -0,0 +1,57 @@
+#include "QuadBatch.h"
+#include <algorithm>
+
+QuadBatch::QuadBatch() {
+	size = 0;
+	stride = 0;
+	updateArrays();
+}
+
+void QuadBatch::resize(size_t size) {
+
+	// Grow the storage when the padded arrays do not fit anymore
+	size_t paddedSize = (size + LANE_PADDING - 1) / LANE_PADDING * LANE_PADDING;
+	if (paddedSize > stride) {
+		std::vector<float> storage(paddedSize * ARRAY_COUNT, 0.0f);
+		for (size_t i = 0; i < ARRAY_COUNT; i++) {
+			std::copy(coordinates.begin() + i * stride, coordinates.begin() + i * stride + std::min(size, this->size), storage.begin() + i * paddedSize);
+		}
+		coordinates.swap(storage);
+		stride = paddedSize;
+		updateArrays();
+	} else if (size > this->size) {
+
+		// Clear the quadrilaterals that are added back, the rest of the padding is still zero
+		for (size_t i = 0; i < ARRAY_COUNT; i++) {
+			std::fill(coordinates.begin() + i * stride + this->size, coordinates.begin() + i * stride + size, 0.0f);
+		}
+	} else {
+
+		// Clear the removed quadrilaterals so that the padding stays zero
+		for (size_t i = 0; i < ARRAY_COUNT; i++) {
+			std::fill(coordinates.begin() + i * stride + size, coordinates.begin() + i * stride + this->size, 0.0f);
+		}
+	}
+	this->size = size;
+}
+
+void QuadBatch::clear() {
+	resize(0);
+}
+
+size_t QuadBatch::getSize() const {
+	return size;
+}
+
+void QuadBatch::updateArrays() {
+
+	// Every array starts a padded length after the previous one
+	float* arrays[ARRAY_COUNT];
+	for (size_t i = 0; i < ARRAY_COUNT; i++) {
+		arrays[i] = coordinates.data() + i * stride;
+	}
+	ax = arrays[0]; ay = arrays[1]; az = arrays[2];
+	bx = arrays[3]; by = arrays[4]; bz = arrays[5];
+	cx = arrays[6]; cy = arrays[7]; cz = arrays[8];
+	dx = arrays[9]; dy = arrays[10]; dz = arrays[11];
+}
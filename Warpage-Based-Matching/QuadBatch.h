@@ -0,0 +1,59 @@
+#ifndef QUAD_BATCH
+#define QUAD_BATCH
+
+#include "Vertex.h"
+#include <vector>
+#include <cstddef>
+
+// Quadrilaterals in structure-of-arrays form, every coordinate of every corner has its own array
+// The arrays are padded with zeros to a whole number of the widest vector so the kernels can always load full vectors
+class QuadBatch {
+public:
+
+	// Number of coordinate arrays, three for each of the four corners
+	const static size_t ARRAY_COUNT = 12;
+
+	// Every array is padded to a multiple of this many elements
+	const static size_t LANE_PADDING = 16;
+
+	// Constructor of an empty batch
+	QuadBatch();
+
+	// Resizes the batch keeping the quadrilaterals that fit, the new ones are all zeros
+	void resize(size_t size);
+
+	// Removes every quadrilateral while keeping the memory
+	void clear();
+
+	// Stores the corners of the quadrilateral at the given index
+	void set(size_t index, const Vertex &a, const Vertex &b, const Vertex &c, const Vertex &d) {
+		ax[index] = a.x; ay[index] = a.y; az[index] = a.z;
+		bx[index] = b.x; by[index] = b.y; bz[index] = b.z;
+		cx[index] = c.x; cy[index] = c.y; cz[index] = c.z;
+		dx[index] = d.x; dy[index] = d.y; dz[index] = d.z;
+	}
+
+	// Returns the number of quadrilaterals
+	size_t getSize() const;
+
+	// Coordinate arrays of the corners
+	float* ax; float* ay; float* az;
+	float* bx; float* by; float* bz;
+	float* cx; float* cy; float* cz;
+	float* dx; float* dy; float* dz;
+
+private:
+
+	// Number of quadrilaterals and the padded length of every array
+	size_t size;
+	size_t stride;
+
+	// Storage of the arrays one after another
+	std::vector<float> coordinates;
+
+	// Points the arrays into the storage
+	void updateArrays();
+
+};
+
+#endif
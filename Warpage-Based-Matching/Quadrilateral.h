@@ -1,24 +1,18 @@
 #ifndef QUADRILATERAL
 #define QUADRILATERAL
 
-#include "Primitive.h"
+#include "Vertex.h"
 
-class Quadrilateral : public Primitive {
-public:
+// Plain aggregate of the corner points, created with brace initialization like Quadrilateral{a, b, c, d}
+struct Quadrilateral {
 
-	const static int POINT_COUNT = 4;
+	static const int POINT_COUNT = 4;
 
 	Vertex a;
 	Vertex b;
 	Vertex c;
 	Vertex d;
 
-	Quadrilateral();
-	Quadrilateral(const Vertex &a, const Vertex &b, const Vertex &c, const Vertex &d);
-	Quadrilateral(const Quadrilateral& quadrilateral);
-
-	void output(std::string filename) const;
-
 };
 
 #endif
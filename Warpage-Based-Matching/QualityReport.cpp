@@ -0,0 +1,122 @@
+#include "QualityReport.h"
+#include "QuadBatch.h"
+#include "BatchEvaluationFunctions.h"
+#include "ParallelFunctions.h"
+#include <algorithm>
+#include <vector>
+#include <cmath>
+
+// Number of quadrilaterals gathered into a batch at once
+#define REPORT_BLOCK_SIZE 4096
+
+// Running sums of a metric before the mean is taken
+struct MetricTotals {
+	double minimum;
+	double maximum;
+	double sum;
+	size_t validCount;
+	size_t invalidCount;
+};
+
+QualityReport::QualityReport(const TriangularMesh* mesh, const std::map<unsigned int, unsigned int> &matching) {
+
+	// Collect the matched face pairs so that they can be split between the threads
+	std::vector<std::pair<unsigned int, unsigned int> > matchedFaces(matching.begin(), matching.end());
+	quadCount = matchedFaces.size();
+
+	// The batch kernels in order of the metrics
+	const BatchKernel kernels[QUALITY_METRIC_COUNT] = {
+		BatchEvaluationFunctions::calculateMaximumWarpage,
+		BatchEvaluationFunctions::calculateMinimumScaledJacobian,
+		BatchEvaluationFunctions::calculateDistortion,
+		BatchEvaluationFunctions::calculateDistortion2,
+		BatchEvaluationFunctions::calculateAspectRatio
+	};
+
+	// Every thread sums the metrics of its own quadrilaterals block by block
+	MetricTotals empty = { INFINITY, -INFINITY, 0.0, 0, 0 };
+	std::vector<MetricTotals> totals(ParallelFunctions::getThreadCount() * QUALITY_METRIC_COUNT, empty);
+	ParallelFunctions::parallelFor(0, quadCount, [&](size_t first, size_t last, unsigned int thread) {
+		QuadBatch batch;
+		std::vector<float> results;
+		for (size_t begin = first; begin < last; begin += REPORT_BLOCK_SIZE) {
+
+			// Gather the corners of the quadrilaterals, the shared half-edge is the vertical diagonal
+			size_t end = std::min<size_t>(begin + REPORT_BLOCK_SIZE, last);
+			batch.resize(end - begin);
+			for (size_t i = begin; i < end; i++) {
+				unsigned int halfEdge = mesh->findSharedHalfEdge(matchedFaces[i].first, matchedFaces[i].second);
+				unsigned int twin = mesh->getTwin(halfEdge);
+				batch.set(i - begin,
+					mesh->getCoordinate(mesh->getOrigin(halfEdge)),
+					mesh->getCoordinate(mesh->getOrigin(TriangularMesh::getPrevious(twin))),
+					mesh->getCoordinate(mesh->getOrigin(twin)),
+					mesh->getCoordinate(mesh->getOrigin(TriangularMesh::getPrevious(halfEdge))));
+			}
+
+			// Evaluate every metric on the batch and add the values to the totals of the thread
+			results.resize(end - begin);
+			for (size_t metric = 0; metric < QUALITY_METRIC_COUNT; metric++) {
+				kernels[metric](batch, results.data());
+				MetricTotals &total = totals[thread * QUALITY_METRIC_COUNT + metric];
+				for (size_t i = 0; i < results.size(); i++) {
+					float value = results[i];
+					if (std::isnan(value)) {
+						total.invalidCount++;
+						continue;
+					}
+					total.minimum = std::min(total.minimum, (double) value);
+					total.maximum = std::max(total.maximum, (double) value);
+					total.sum += value;
+					total.validCount++;
+				}
+			}
+		}
+	}, REPORT_BLOCK_SIZE);
+
+	// Merge the totals of the threads into the summaries
+	for (size_t metric = 0; metric < QUALITY_METRIC_COUNT; metric++) {
+		MetricTotals total = empty;
+		for (size_t thread = 0; thread < totals.size() / QUALITY_METRIC_COUNT; thread++) {
+			const MetricTotals &threadTotal = totals[thread * QUALITY_METRIC_COUNT + metric];
+			total.minimum = std::min(total.minimum, threadTotal.minimum);
+			total.maximum = std::max(total.maximum, threadTotal.maximum);
+			total.sum += threadTotal.sum;
+			total.validCount += threadTotal.validCount;
+			total.invalidCount += threadTotal.invalidCount;
+		}
+
+		// A metric without any valid value has no range either
+		MetricSummary &summary = summaries[metric];
+		summary.minimum = total.validCount == 0 ? NAN : total.minimum;
+		summary.maximum = total.validCount == 0 ? NAN : total.maximum;
+		summary.mean = total.validCount == 0 ? NAN : total.sum / total.validCount;
+		summary.invalidCount = total.invalidCount;
+	}
+}
+
+size_t QualityReport::getQuadCount() const {
+	return quadCount;
+}
+
+const MetricSummary& QualityReport::getSummary(QualityMetric metric) const {
+	return summaries[metric];
+}
+
+const char* QualityReport::getMetricName(QualityMetric metric) {
+
+	// Return the name of the metric after its evaluation function
+	switch (metric) {
+	case MAXIMUM_WARPAGE_METRIC:
+		return "maximumWarpage";
+	case MINIMUM_SCALED_JACOBIAN_METRIC:
+		return "minimumScaledJacobian";
+	case DISTORTION_METRIC:
+		return "distortion";
+	case DISTORTION2_METRIC:
+		return "distortion2";
+	case ASPECT_RATIO_METRIC:
+		return "aspectRatio";
+	}
+	return "unknown";
+}
@@ -0,0 +1,52 @@
+#ifndef QUALITY_REPORT
+#define QUALITY_REPORT
+
+#include "TriangularMesh.h"
+#include <map>
+#include <cstddef>
+
+enum QualityMetric {
+	MAXIMUM_WARPAGE_METRIC,
+	MINIMUM_SCALED_JACOBIAN_METRIC,
+	DISTORTION_METRIC,
+	DISTORTION2_METRIC,
+	ASPECT_RATIO_METRIC
+};
+
+// Number of the quality metrics
+#define QUALITY_METRIC_COUNT 5
+
+// Range and mean of a metric, NaN values are only counted
+struct MetricSummary {
+	double minimum;
+	double maximum;
+	double mean;
+	size_t invalidCount;
+};
+
+// Quality of the quadrilaterals of a matching, evaluated with the batch kernels of every metric
+class QualityReport {
+public:
+
+	// Evaluates the quadrilaterals formed by the matched face pairs
+	QualityReport(const TriangularMesh* mesh, const std::map<unsigned int, unsigned int> &matching);
+
+	// Returns the number of evaluated quadrilaterals
+	size_t getQuadCount() const;
+
+	// Returns the summary of the metric
+	const MetricSummary& getSummary(QualityMetric metric) const;
+
+	// Returns the name of the metric
+	static const char* getMetricName(QualityMetric metric);
+
+private:
+
+	size_t quadCount;
+
+	// Summaries indexed by the metric
+	MetricSummary summaries[QUALITY_METRIC_COUNT];
+
+};
+
+#endif
@@ -0,0 +1,79 @@
+#include "SortedMatching.h"
+#include "ParallelFunctions.h"
+#include <chrono>
+
+// Smallest number of faces handed to a thread while the edges are scored
+#define MINIMUM_SCORE_RANGE 4096
+
+// Smallest number of edges sorted by a thread
+#define MINIMUM_SORT_RANGE 65536
+
+SortedMatching::SortedMatching(const TriangularMesh* mesh, EdgeMetricCache* metricCache) : MatchingEngine(mesh, metricCache) {
+	scoreSeconds = 0;
+	sortSeconds = 0;
+}
+
+void SortedMatching::initialize() {
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	// Score the edges of the faces in every range on their own thread, an edge belongs to the face of its smaller half-edge
+	size_t faceCount = mesh->getFaceCount();
+	unsigned int threadCount = ParallelFunctions::getThreadCount();
+	std::vector<std::vector<std::pair<double, unsigned int> > > rangeCandidates(threadCount);
+	ParallelFunctions::parallelFor(0, faceCount, [&](size_t first, size_t last, unsigned int thread) {
+		std::vector<std::pair<double, unsigned int> > &local = rangeCandidates[thread];
+		for (unsigned int halfEdge = (unsigned int) first * 3; halfEdge < last * 3; halfEdge++) {
+			unsigned int twin = mesh->getTwin(halfEdge);
+			if (twin == INVALID_INDEX || twin < halfEdge) {
+				continue;
+			}
+			double value = metricCache->getStoredMaximumWarpage(halfEdge);
+			if (value < 360) {
+				local.push_back(std::make_pair(value, halfEdge));
+			}
+		}
+	}, MINIMUM_SCORE_RANGE);
+
+	// Join the edges of the ranges in order
+	size_t candidateCount = 0;
+	for (unsigned int thread = 0; thread < threadCount; thread++) {
+		candidateCount += rangeCandidates[thread].size();
+	}
+	candidates.clear();
+	candidates.reserve(candidateCount);
+	for (unsigned int thread = 0; thread < threadCount; thread++) {
+		candidates.insert(candidates.end(), rangeCandidates[thread].begin(), rangeCandidates[thread].end());
+		std::vector<std::pair<double, unsigned int> >().swap(rangeCandidates[thread]);
+	}
+	std::chrono::steady_clock::time_point sortStart = std::chrono::steady_clock::now();
+	scoreSeconds = std::chrono::duration<double>(sortStart - start).count();
+
+	// Sort the edges on their metric values, the half-edges break the ties
+	ParallelFunctions::parallelSort(candidates, std::less<std::pair<double, unsigned int> >(), MINIMUM_SORT_RANGE);
+	sortSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - sortStart).count();
+}
+
+void SortedMatching::calculateMatching(std::map<unsigned int, unsigned int> &matching, std::vector<unsigned int> &unmatchedFaces) {
+
+	// Pair the faces of every edge in order while both are free
+	size_t faceCount = mesh->getFaceCount();
+	std::vector<unsigned int> partners(faceCount, INVALID_INDEX);
+	for (size_t i = 0; i < candidates.size(); i++) {
+		unsigned int halfEdge = candidates[i].second;
+		unsigned int face = halfEdge / 3;
+		unsigned int neighbor = mesh->getTwin(halfEdge) / 3;
+		if (partners[face] == INVALID_INDEX && partners[neighbor] == INVALID_INDEX) {
+			partners[face] = neighbor;
+			partners[neighbor] = face;
+		}
+	}
+
+	// Add the pairs under their smaller face and the faces left alone in increasing order
+	collectMatching(partners, matching, unmatchedFaces);
+}
+
+void SortedMatching::addStatistics(std::map<std::string, double> &statistics) const {
+	statistics["candidateEdgeCount"] = (double) candidates.size();
+	statistics["scoreSeconds"] = scoreSeconds;
+	statistics["sortSeconds"] = sortSeconds;
+}
@@ -0,0 +1,31 @@
+#ifndef SORTED_MATCHING
+#define SORTED_MATCHING
+
+#include "MatchingEngine.h"
+#include <utility>
+
+// Edge-centric greedy matching, every interior edge is scored once and all edges are sorted on their metric values
+// A single sweep over the sorted edges pairs the two faces of an edge if both are still free
+// There are no queue updates, equal metric values are ordered by the half-edge so the matching is the same for every thread count
+class SortedMatching : public MatchingEngine {
+public:
+
+	// Constructor
+	SortedMatching(const TriangularMesh* mesh, EdgeMetricCache* metricCache);
+
+	void initialize();
+	void calculateMatching(std::map<unsigned int, unsigned int> &matching, std::vector<unsigned int> &unmatchedFaces);
+	void addStatistics(std::map<std::string, double> &statistics) const;
+
+private:
+
+	// Metric value and smaller half-edge of every interior edge with a valid quadrilateral, sorted in increasing order
+	std::vector<std::pair<double, unsigned int> > candidates;
+
+	// Wall-clock seconds spent on the scoring and the sort
+	double scoreSeconds;
+	double sortSeconds;
+
+};
+
+#endif
@@ -1,23 +1,17 @@
 #ifndef TRIANGLE
 #define TRIANGLE
 
-#include "Primitive.h"
+#include "Vertex.h"
 
-class Triangle : public Primitive {
-public:
+// Plain aggregate of the corner points, created with brace initialization like Triangle{a, b, c}
+struct Triangle {
 
-	const static int POINT_COUNT = 3;
+	static const int POINT_COUNT = 3;
 
 	Vertex a;
 	Vertex b;
 	Vertex c;
 
-	Triangle();
-	Triangle(const Vertex &a, const Vertex &b, const Vertex &c);
-	Triangle(const Triangle& triangle);
-	
-	void output(std::string filename) const;
-
 };
 
 #endif
@@ -1,124 +1,234 @@
 #include "TriangularMesh.h"
+#include "ParallelFunctions.h"
+#include <algorithm>
+#include <cmath>
 
-TriangularMesh::TriangularMesh(std::vector<Vertex> vertexList, std::vector<Face> faceList) {
+// Half-edges are not paired on multiple threads below this count per thread
+#define MINIMUM_PAIRING_RANGE (1 << 16)
 
-	// Create and store the vertex data
-	vertexCount = vertexList.size();
-	for (size_t i = 0; i < vertexCount; i++) {
+// Face normals are not calculated on multiple threads below this count per thread
+#define MINIMUM_NORMAL_RANGE (1 << 14)
 
-		// Create a new vertex data
-		VertexData* vertex = new VertexData();
+// Vertex and face lists are read as flat coordinate and index arrays
+static_assert(sizeof(Vertex) == 3 * sizeof(float), "Vertex must consist of three packed floats");
+static_assert(sizeof(Face) == 3 * sizeof(unsigned int), "Face must consist of three packed indices");
 
-		// Set vertex id in order to find the coordinates using index information
-		vertex->id = i;
+TriangularMesh::TriangularMesh(std::vector<Vertex> vertices, std::vector<Face> faces) {
 
-		// Copy the coordinate information to vertex data
-		vertex->coordinate = vertexList[i];
+	// Take over the lists, the face indices already are the half-edge origins in face order
+	vertexCount = vertices.size();
+	faceCount = faces.size();
+	vertexList.swap(vertices);
+	faceList.swap(faces);
+	coordinates = vertexList.data();
+	origins = reinterpret_cast<const unsigned int*>(faceList.data());
 
-		// Store the vertex information
-		vertices.push_back(vertex);
-	}
+	// Build the half-edges on the lists
+	arena.reserve(getBuildSize());
+	build();
+}
 
-	// Create and store the face information using half-edges
-	faceCount = faceList.size();
-	for (size_t i = 0; i < faceCount; i++) {
+TriangularMesh::TriangularMesh(MappedFile &file, size_t vertexOffset, size_t vertexCount, size_t faceOffset, size_t faceCount) {
 
-		// Create a new face for each triangle
-		Face triangle = faceList[i];
-		FaceData* face = new FaceData();
+	// Take over the mapping, the face indices already are the half-edge origins in face order
+	this->vertexCount = vertexCount;
+	this->faceCount = faceCount;
+	mappedFile.swap(file);
+	coordinates = reinterpret_cast<const Vertex*>(mappedFile.getData() + vertexOffset);
+	origins = reinterpret_cast<const unsigned int*>(mappedFile.getData() + faceOffset);
 
-		// Create original half-edges
-		HalfEdgeData* halfEdge1 = new HalfEdgeData();
-		HalfEdgeData* halfEdge2 = new HalfEdgeData();
-		HalfEdgeData* halfEdge3 = new HalfEdgeData();
+	// Build the half-edges on the mapped blocks
+	arena.reserve(getBuildSize());
+	build();
+}
 
-		// Set the face information to half-edges
-		halfEdge1->face = face;
-		halfEdge2->face = face;
-		halfEdge3->face = face;
+void TriangularMesh::build() {
 
-		// Set the origination vertices to the half-edges
-		halfEdge1->origin = vertices[triangle.a];
-		halfEdge2->origin = vertices[triangle.b];
-		halfEdge3->origin = vertices[triangle.c];
+	// Allocate the twins and the face arrays, the arena is already reserved by the constructors
+	twins = arena.allocate<unsigned int>(getHalfEdgeCount());
+	faceNormals = arena.allocate<Vertex>(faceCount);
+	faceAreas = arena.allocate<float>(faceCount);
 
-		// Set the face half-edges on the surface
-		halfEdge1->next = halfEdge2;
-		halfEdge2->next = halfEdge3;
-		halfEdge3->next = halfEdge1;
+	// Pair the half-edges of the neighboring faces, half-edges without a pair stay on the boundary
+	pairHalfEdges();
 
-		// Pair the half edges
-		pairHalfEdges(triangle.a, triangle.b, halfEdge1);
-		pairHalfEdges(triangle.b, triangle.c, halfEdge2);
-		pairHalfEdges(triangle.c, triangle.a, halfEdge3);
+	// Calculate the face normals that the quadrilateral metrics share
+	calculateFaceNormals();
+}
 
-		// Set half edge information to the vertices
-		vertices[triangle.a]->half = halfEdge1;
-		vertices[triangle.b]->half = halfEdge2;
-		vertices[triangle.c]->half = halfEdge3;
+size_t TriangularMesh::getBuildSize() const {
+	return MonotonicArena::ALIGNMENT * 3 + getHalfEdgeCount() * sizeof(unsigned int) + faceCount * (sizeof(Vertex) + sizeof(float));
+}
 
-		// Set the first half-edge as the half-edge of the face
-		face->half = halfEdge1;
+TriangularMesh::~TriangularMesh() {
 
-		// Set face id in order to find it when needed
-		face->id = i;
+	// Release the arena arrays at once, the lists and the mapping release themselves
+	arena.release();
+}
 
-		// Initially assign all faces to priority set 0
-		face->priority = 0;
+void TriangularMesh::pairHalfEdges() {
 
-		// Store the face information
-		faces.push_back(face);
+	// Every thread owns a contiguous slice of the half-edges and a range of the vertices
+	size_t halfEdgeCount = getHalfEdgeCount();
+	size_t rangeCount = std::max<size_t>(1, std::min<size_t>(ParallelFunctions::getThreadCount(), halfEdgeCount / MINIMUM_PAIRING_RANGE));
+	std::vector<unsigned int> rangeBegins(rangeCount + 1);
+	std::vector<size_t> sliceBegins(rangeCount + 1);
+	for (size_t i = 0; i <= rangeCount; i++) {
+		rangeBegins[i] = (unsigned int) (vertexCount * i / rangeCount);
+		sliceBegins[i] = halfEdgeCount * i / rangeCount;
 	}
-}
 
-TriangularMesh::~TriangularMesh() {
+	// Returns the vertex range that holds the smaller vertex of the half-edge
+	auto findRange = [&](size_t halfEdge) {
+		unsigned int vertex = getMinimumVertex((unsigned int) halfEdge);
+		return (size_t) (std::upper_bound(rangeBegins.begin() + 1, rangeBegins.end() - 1, vertex) - rangeBegins.begin() - 1);
+	};
+
+	// Count the half-edges of every slice that fall into every vertex range
+	std::vector<size_t> sliceOffsets(rangeCount * rangeCount, 0);
+	ParallelFunctions::parallelFor(0, rangeCount, [&](size_t first, size_t last, unsigned int) {
+		for (size_t slice = first; slice < last; slice++) {
+			for (size_t halfEdge = sliceBegins[slice]; halfEdge < sliceBegins[slice + 1]; halfEdge++) {
+				sliceOffsets[findRange(halfEdge) * rangeCount + slice]++;
+			}
+		}
+	});
 
-	// Delete all faces
-	for (size_t i = 0; i < faceCount; i++) {
-		delete faces[i];
-		faces[i] = 0;
+	// Turn the counts into the first positions, the half-edges of a range follow each other in slice order
+	std::vector<size_t> rangeOffsets(rangeCount + 1, 0);
+	size_t offset = 0;
+	for (size_t i = 0; i < rangeCount * rangeCount; i++) {
+		size_t count = sliceOffsets[i];
+		sliceOffsets[i] = offset;
+		offset += count;
+		if (i % rangeCount == rangeCount - 1) {
+			rangeOffsets[i / rangeCount + 1] = offset;
+		}
 	}
 
-	// Delete all vertices with half edge data
-	for (size_t i = 0; i < vertexCount; i++) {
+	// Scatter the half-edges of every slice into their ranges, which keeps them in index order inside every range
+	std::vector<unsigned int> rangeHalfEdges(halfEdgeCount);
+	ParallelFunctions::parallelFor(0, rangeCount, [&](size_t first, size_t last, unsigned int) {
+		for (size_t slice = first; slice < last; slice++) {
+			for (size_t halfEdge = sliceBegins[slice]; halfEdge < sliceBegins[slice + 1]; halfEdge++) {
+				rangeHalfEdges[sliceOffsets[findRange(halfEdge) * rangeCount + slice]++] = (unsigned int) halfEdge;
+			}
+		}
+	});
 
-		// Delete the pair of the half edge
-		HalfEdgeData* pair = vertices[i]->half->pair;
-		delete pair;
-		pair = 0;
+	// Bucket the half-edges of every range by their smaller vertex, the ranges own disjoint buckets
+	std::vector<unsigned int> bucketBegins(vertexCount + 1, 0);
+	std::vector<unsigned int> buckets(halfEdgeCount);
+	ParallelFunctions::parallelFor(0, rangeCount, [&](size_t first, size_t last, unsigned int) {
+		for (size_t range = first; range < last; range++) {
 
-		// Delete the half edge
-		HalfEdgeData* half = vertices[i]->half;
-		delete half;
-		half = 0;
+			// Count the half-edges of every bucket
+			for (size_t i = rangeOffsets[range]; i < rangeOffsets[range + 1]; i++) {
+				bucketBegins[getMinimumVertex(rangeHalfEdges[i])]++;
+			}
 
-		// Delete the vertex
-		delete vertices[i];
-		vertices[i] = 0;
+			// Find the first position of every bucket
+			unsigned int position = (unsigned int) rangeOffsets[range];
+			for (size_t vertex = rangeBegins[range]; vertex < rangeBegins[range + 1]; vertex++) {
+				unsigned int count = bucketBegins[vertex];
+				bucketBegins[vertex] = position;
+				position += count;
+			}
+
+			// Place the half-edges into their buckets in index order
+			std::vector<unsigned int> positions(bucketBegins.begin() + rangeBegins[range], bucketBegins.begin() + rangeBegins[range + 1]);
+			for (size_t i = rangeOffsets[range]; i < rangeOffsets[range + 1]; i++) {
+				unsigned int halfEdge = rangeHalfEdges[i];
+				buckets[positions[getMinimumVertex(halfEdge) - rangeBegins[range]]++] = halfEdge;
+			}
+		}
+	});
+	bucketBegins[vertexCount] = (unsigned int) halfEdgeCount;
+
+	// Sort every bucket by the larger vertex and pair the two opposite half-edges of every manifold edge
+	std::fill(twins, twins + halfEdgeCount, INVALID_INDEX);
+	std::vector<size_t> boundaryCounts(rangeCount, 0);
+	std::vector<size_t> nonManifoldCounts(rangeCount, 0);
+	ParallelFunctions::parallelFor(0, rangeCount, [&](size_t first, size_t last, unsigned int) {
+		for (size_t range = first; range < last; range++) {
+			for (size_t vertex = rangeBegins[range]; vertex < rangeBegins[range + 1]; vertex++) {
+
+				// Order the half-edges of the bucket by their edge and then by their index
+				unsigned int* bucket = &buckets[bucketBegins[vertex]];
+				unsigned int* bucketEnd = &buckets[bucketBegins[vertex + 1]];
+				std::sort(bucket, bucketEnd, [this](unsigned int lhs, unsigned int rhs) {
+					unsigned int lhsVertex = getMaximumVertex(lhs);
+					unsigned int rhsVertex = getMaximumVertex(rhs);
+					return lhsVertex < rhsVertex || (lhsVertex == rhsVertex && lhs < rhs);
+				});
+
+				// Walk the edges of the bucket
+				unsigned int* edge = bucket;
+				while (edge < bucketEnd) {
+
+					// Find the half-edges of the current edge
+					unsigned int* edgeEnd = edge + 1;
+					while (edgeEnd < bucketEnd && getMaximumVertex(*edgeEnd) == getMaximumVertex(*edge)) {
+						edgeEnd++;
+					}
+
+					// Only two half-edges in opposite directions can be twins
+					if (edgeEnd - edge == 1) {
+						boundaryCounts[range]++;
+					} else if (edgeEnd - edge == 2 && origins[edge[0]] != origins[edge[1]]) {
+						twins[edge[0]] = edge[1];
+						twins[edge[1]] = edge[0];
+					} else {
+						nonManifoldCounts[range]++;
+					}
+					edge = edgeEnd;
+				}
+			}
+		}
+	});
+
+	// Sum the counts of the ranges
+	boundaryEdgeCount = 0;
+	nonManifoldEdgeCount = 0;
+	for (size_t i = 0; i < rangeCount; i++) {
+		boundaryEdgeCount += boundaryCounts[i];
+		nonManifoldEdgeCount += nonManifoldCounts[i];
 	}
 }
 
-void TriangularMesh::pairHalfEdges(unsigned int origin, unsigned int destination, HalfEdgeData* halfEdge) {
+void TriangularMesh::calculateFaceNormals() {
 
-	// For the given half-edge, check if its pair already added to the map and if so, pair them
-	VertexPair lookupKey = std::make_pair(destination, origin);
-	if (lookupMap.find(lookupKey) != lookupMap.end()) {
-		HalfEdgeData* pair = lookupMap[lookupKey];
-		halfEdge->pair = pair;
-		pair->pair = halfEdge;
-		lookupMap.erase(lookupKey);
-	} else {
-		VertexPair insertionKey = std::make_pair(origin, destination);
-		lookupMap.insert(std::make_pair(insertionKey, halfEdge));
-	}
+	// Every face is independent, split them into contiguous ranges
+	ParallelFunctions::parallelFor(0, faceCount, [this](size_t first, size_t last, unsigned int) {
+		for (size_t face = first; face < last; face++) {
+
+			// Get the corners of the face in winding order
+			const unsigned int* corners = &origins[face * 3];
+			const Vertex &a = coordinates[corners[0]];
+			const Vertex &b = coordinates[corners[1]];
+			const Vertex &c = coordinates[corners[2]];
+
+			// The cross product of the edges leaving the first corner has twice the area as its length
+			double abX = (double) b.x - a.x, abY = (double) b.y - a.y, abZ = (double) b.z - a.z;
+			double acX = (double) c.x - a.x, acY = (double) c.y - a.y, acZ = (double) c.z - a.z;
+			double x = abY * acZ - abZ * acY;
+			double y = abZ * acX - abX * acZ;
+			double z = abX * acY - abY * acX;
+			double length = sqrt(x * x + y * y + z * z);
+
+			// Store the unit normal, a degenerate face divides by zero and gets NaN components
+			faceNormals[face] = Vertex((float) (x / length), (float) (y / length), (float) (z / length));
+			faceAreas[face] = (float) (length / 2);
+		}
+	}, MINIMUM_NORMAL_RANGE);
 }
 
-const std::vector<VertexData*> TriangularMesh::getVertices() const {
-	return vertices;
+unsigned int TriangularMesh::getMinimumVertex(unsigned int halfEdge) const {
+	return std::min(origins[halfEdge], origins[getNext(halfEdge)]);
 }
 
-const std::vector<FaceData*> TriangularMesh::getFaces() const {
-	return faces;
+unsigned int TriangularMesh::getMaximumVertex(unsigned int halfEdge) const {
+	return std::max(origins[halfEdge], origins[getNext(halfEdge)]);
 }
 
 size_t TriangularMesh::getVertexCount() const {
@@ -128,3 +238,35 @@ size_t TriangularMesh::getVertexCount() const {
 size_t TriangularMesh::getFaceCount() const {
 	return faceCount;
 }
+
+size_t TriangularMesh::getHalfEdgeCount() const {
+	return faceCount * 3;
+}
+
+ArrayView<Vertex> TriangularMesh::getCoordinates() const {
+	return ArrayView<Vertex>(coordinates, vertexCount);
+}
+
+ArrayView<unsigned int> TriangularMesh::getOrigins() const {
+	return ArrayView<unsigned int>(origins, getHalfEdgeCount());
+}
+
+ArrayView<unsigned int> TriangularMesh::getTwins() const {
+	return ArrayView<unsigned int>(twins, getHalfEdgeCount());
+}
+
+ArrayView<Vertex> TriangularMesh::getFaceNormals() const {
+	return ArrayView<Vertex>(faceNormals, faceCount);
+}
+
+ArrayView<float> TriangularMesh::getFaceAreas() const {
+	return ArrayView<float>(faceAreas, faceCount);
+}
+
+size_t TriangularMesh::getBoundaryEdgeCount() const {
+	return boundaryEdgeCount;
+}
+
+size_t TriangularMesh::getNonManifoldEdgeCount() const {
+	return nonManifoldEdgeCount;
+}
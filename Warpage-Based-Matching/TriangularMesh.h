@@ -2,31 +2,146 @@
 #define TRIANGULAR_MESH
 
 #include "Definitions.h"
+#include "MonotonicArena.h"
+#include "ArrayView.h"
+#include "MappedFile.h"
 #include <vector>
+#include <cstddef>
 
+// Half-edges 3f, 3f + 1 and 3f + 2 belong to face f and run a -> b, b -> c and c -> a,
+// so the next half-edge and the face of a half-edge are computed instead of stored
 class TriangularMesh {
 public:
 
+	// Takes over the memory of the lists, pass them with std::move to avoid copying them
 	TriangularMesh(std::vector<Vertex> vertices, std::vector<Face> faces);
-	~TriangularMesh();
 
-	const std::vector<VertexData*> getVertices() const;
-	const std::vector<FaceData*> getFaces() const;
+	// Takes over the mapping of the file and uses its coordinate and index blocks in place, the blocks at the offsets must be aligned
+	TriangularMesh(MappedFile &file, size_t vertexOffset, size_t vertexCount, size_t faceOffset, size_t faceCount);
+	~TriangularMesh();
 
 	size_t getVertexCount() const;
 	size_t getFaceCount() const;
+	size_t getHalfEdgeCount() const;
 
-private:
+	// Returns the number of edges with a single half-edge
+	size_t getBoundaryEdgeCount() const;
+
+	// Returns the number of edges whose half-edges cannot be paired, they are treated as boundary edges
+	size_t getNonManifoldEdgeCount() const;
+
+	// Views of the vertex coordinates and the origins and twins of the half-edges
+	ArrayView<Vertex> getCoordinates() const;
+	ArrayView<unsigned int> getOrigins() const;
+	ArrayView<unsigned int> getTwins() const;
+
+	// Views of the face normals and areas
+	ArrayView<Vertex> getFaceNormals() const;
+	ArrayView<float> getFaceAreas() const;
+
+	// Returns the coordinates of a vertex
+	const Vertex& getCoordinate(unsigned int vertex) const {
+		return coordinates[vertex];
+	}
+
+	// Returns the vertex that the half-edge starts from
+	unsigned int getOrigin(unsigned int halfEdge) const {
+		return origins[halfEdge];
+	}
+
+	// Returns the unit normal of the face following its winding, NaN components for a degenerate face
+	const Vertex& getFaceNormal(unsigned int face) const {
+		return faceNormals[face];
+	}
+
+	// Returns the area of the face
+	float getFaceArea(unsigned int face) const {
+		return faceAreas[face];
+	}
+
+	// Returns the opposite half-edge in the neighboring face, INVALID_INDEX on the boundary
+	unsigned int getTwin(unsigned int halfEdge) const {
+		return twins[halfEdge];
+	}
+
+	// Returns the half-edge of the face whose twin belongs to the neighbor, INVALID_INDEX if the faces are not neighbors
+	unsigned int findSharedHalfEdge(unsigned int face, unsigned int neighbor) const {
+		unsigned int firstEdge = getHalfEdge(face);
+		for (unsigned int halfEdge = firstEdge; halfEdge < firstEdge + 3; halfEdge++) {
+			if (twins[halfEdge] != INVALID_INDEX && getFace(twins[halfEdge]) == neighbor) {
+				return halfEdge;
+			}
+		}
+		return INVALID_INDEX;
+	}
+
+	// Returns the face that the half-edge belongs to
+	static unsigned int getFace(unsigned int halfEdge) {
+		return halfEdge / 3;
+	}
+
+	// Returns the first half-edge of the face
+	static unsigned int getHalfEdge(unsigned int face) {
+		return face * 3;
+	}
 
-	std::vector<VertexData*> vertices;
-	std::vector<FaceData*> faces;
+	// Returns the next half-edge around the face
+	static unsigned int getNext(unsigned int halfEdge) {
+		return halfEdge % 3 == 2 ? halfEdge - 2 : halfEdge + 1;
+	}
+
+	// Returns the previous half-edge around the face
+	static unsigned int getPrevious(unsigned int halfEdge) {
+		return halfEdge % 3 == 0 ? halfEdge + 2 : halfEdge - 1;
+	}
+
+private:
 
 	size_t vertexCount;
 	size_t faceCount;
 
-	std::map<VertexPair, HalfEdgeData*> lookupMap;
+	size_t boundaryEdgeCount;
+	size_t nonManifoldEdgeCount;
+
+	// Vertex and face lists taken over from the constructor, the face indices are the half-edge origins
+	std::vector<Vertex> vertexList;
+	std::vector<Face> faceList;
+
+	// Mapped binary mesh whose blocks hold the coordinates and the half-edge origins
+	MappedFile mappedFile;
+
+	// Owner of the remaining element arrays, they are allocated together and released at once
+	MonotonicArena arena;
+
+	// Vertex coordinates
+	const Vertex* coordinates;
+
+	// Origin vertex and twin half-edge of every half-edge
+	const unsigned int* origins;
+	unsigned int* twins;
+
+	// Unit normal and area of every face
+	Vertex* faceNormals;
+	float* faceAreas;
+
+	// Allocates the twins and the face arrays once the coordinates and origins are in place,
+	// then pairs the half-edges and calculates the face normals
+	void build();
+
+	// Calculates the normals and areas of the faces in parallel
+	void calculateFaceNormals();
+
+	// Number of bytes that build allocates from the arena
+	size_t getBuildSize() const;
+
+	// Pairs the twin half-edges by sorting them on their undirected edge keys
+	// Every thread distributes its slice of the half-edges to the vertex ranges, then buckets its range by the smaller vertex
+	// and sorts every bucket by the larger vertex
+	void pairHalfEdges();
 
-	void pairHalfEdges(unsigned int origin, unsigned int destination, HalfEdgeData* halfEdge);
+	// Returns the smaller and larger vertex of the half-edge
+	unsigned int getMinimumVertex(unsigned int halfEdge) const;
+	unsigned int getMaximumVertex(unsigned int halfEdge) const;
 
 };
 
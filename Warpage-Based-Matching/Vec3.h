@@ -0,0 +1,70 @@
+#ifndef VEC3
+#define VEC3
+
+#include "Vertex.h"
+#include <cmath>
+
+// Trivially copyable double precision vector for the geometric calculations, small enough to stay in registers
+struct Vec3 {
+
+	double x;
+	double y;
+	double z;
+
+	constexpr Vec3(double x = 0.0, double y = 0.0, double z = 0.0) : x(x), y(y), z(z) {
+
+	}
+
+	// Creates the vector pointing from the start vertex to the end vertex, the difference is taken in double precision
+	constexpr Vec3(const Vertex &start, const Vertex &end) : x((double) end.x - start.x), y((double) end.y - start.y), z((double) end.z - start.z) {
+
+	}
+
+	constexpr Vec3 operator+(const Vec3 &vector) const {
+		return Vec3(x + vector.x, y + vector.y, z + vector.z);
+	}
+
+	constexpr Vec3 operator-(const Vec3 &vector) const {
+		return Vec3(x - vector.x, y - vector.y, z - vector.z);
+	}
+
+	constexpr Vec3 operator-() const {
+		return Vec3(-x, -y, -z);
+	}
+
+	constexpr Vec3 operator*(const double value) const {
+		return Vec3(value * x, value * y, value * z);
+	}
+
+	constexpr Vec3 operator/(const double value) const {
+		return Vec3(x / value, y / value, z / value);
+	}
+
+	constexpr double dot(const Vec3 &vector) const {
+		return x * vector.x + y * vector.y + z * vector.z;
+	}
+
+	constexpr Vec3 cross(const Vec3 &vector) const {
+		return Vec3(y * vector.z - z * vector.y, z * vector.x - x * vector.z, x * vector.y - y * vector.x);
+	}
+
+	constexpr double getSquaredLength() const {
+		return dot(*this);
+	}
+
+	double getLength() const {
+		return sqrt(getSquaredLength());
+	}
+
+	// Converts the vector into a single precision vertex
+	constexpr Vertex toVertex() const {
+		return Vertex((float) x, (float) y, (float) z);
+	}
+
+	// Returns the unit vector in the same direction, the components are not finite for a zero vector
+	Vec3 normalize() const {
+		return *this / getLength();
+	}
+};
+
+#endif
@@ -7,35 +7,27 @@ struct Vertex {
 	float y;
 	float z;
 
-	Vertex(float x = 0.0f, float y = 0.0f, float z = 0.0f) {
-		this->x = x;
-		this->y = y;
-		this->z = z;
-	}
+	constexpr Vertex(float x = 0.0f, float y = 0.0f, float z = 0.0f) : x(x), y(y), z(z) {
 
-	Vertex(const Vertex& vertex) { 
-		x = vertex.x;
-		y = vertex.y;
-		z = vertex.z;
 	}
 
-	Vertex operator+(const Vertex& vertex) const {
+	constexpr Vertex operator+(const Vertex& vertex) const {
 		return Vertex(x + vertex.x, y + vertex.y, z + vertex.z);
 	}
 
-	Vertex operator-(const Vertex& vertex) const {
+	constexpr Vertex operator-(const Vertex& vertex) const {
 		return Vertex(x - vertex.x, y - vertex.y, z - vertex.z);
 	}
 
-	Vertex operator*(const float value) const {
+	constexpr Vertex operator*(const float value) const {
 		return Vertex(value * x, value * y, value * z);
 	}
 
-	Vertex operator*(const Vertex& vertex) const {
+	constexpr Vertex operator*(const Vertex& vertex) const {
 		return Vertex(x * vertex.x, y * vertex.y, z * vertex.z);
 	}
 
-	Vertex operator/(const float value) const {
+	constexpr Vertex operator/(const float value) const {
 		float r = float(1.0) / value;
 		return *this * r;
 	}
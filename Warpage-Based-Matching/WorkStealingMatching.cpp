@@ -0,0 +1,251 @@
+#include "WorkStealingMatching.h"
+#include "ParallelFunctions.h"
+#include <algorithm>
+
+// Number of faces in a block, the unit of stealing
+#define STEALING_BLOCK_SIZE 4096
+
+// Smallest number of faces handed to a thread while the priorities are calculated
+#define MINIMUM_PRIORITY_RANGE 4096
+
+// States of the faces that are not matched, face indices never reach these values
+#define FREE_STATE INVALID_INDEX
+#define LOCKED_STATE (INVALID_INDEX - 1)
+
+WorkStealingMatching::WorkStealingMatching(const TriangularMesh* mesh, EdgeMetricCache* metricCache) : MatchingEngine(mesh, metricCache) {
+
+	// Initially every face is free
+	size_t faceCount = mesh->getFaceCount();
+	states.reset(new std::atomic<unsigned int>[faceCount]);
+	for (size_t face = 0; face < faceCount; face++) {
+		states[face].store(FREE_STATE, std::memory_order_relaxed);
+	}
+
+	// Every worker gets its own counters
+	workerCount = ParallelFunctions::getThreadCount();
+	blockRanges.reset(new BlockRange[workerCount]);
+	claimCounts.assign(workerCount, 0);
+	claimConflictCounts.assign(workerCount, 0);
+	stealCounts.assign(workerCount, 0);
+}
+
+void WorkStealingMatching::initialize() {
+
+	// Calculate the starting priority of every face on every thread
+	size_t faceCount = mesh->getFaceCount();
+	priorities.resize(faceCount);
+	ParallelFunctions::parallelFor(0, faceCount, [this](size_t first, size_t last, unsigned int) {
+		for (size_t face = first; face < last; face++) {
+			unsigned int neighbor;
+			bool busy;
+			if (!findCandidate((unsigned int) face, neighbor, priorities[face], busy)) {
+				priorities[face] = 360;
+			}
+		}
+	}, MINIMUM_PRIORITY_RANGE);
+
+	// Split the blocks into contiguous ranges, one for every worker
+	size_t blockCount = (faceCount + STEALING_BLOCK_SIZE - 1) / STEALING_BLOCK_SIZE;
+	for (unsigned int worker = 0; worker < workerCount; worker++) {
+		blockRanges[worker].next = blockCount * worker / workerCount;
+		blockRanges[worker].end = blockCount * (worker + 1) / workerCount;
+	}
+}
+
+void WorkStealingMatching::calculateMatching(std::map<unsigned int, unsigned int> &matching, std::vector<unsigned int> &unmatchedFaces) {
+
+	// Run every worker on its own thread until no block is left anywhere
+	ParallelFunctions::parallelFor(0, workerCount, [this](size_t first, size_t last, unsigned int) {
+		std::vector<FacePriority> heap;
+		for (size_t worker = first; worker < last; worker++) {
+			WorkerCounters counters = { 0, 0, 0 };
+			size_t block;
+			while (takeBlock((unsigned int) worker, block, counters)) {
+				matchBlock(block, heap, counters);
+			}
+			claimCounts[worker] = counters.claimCount;
+			claimConflictCounts[worker] = counters.claimConflictCount;
+			stealCounts[worker] = counters.stealCount;
+		}
+	});
+
+	// Add the pairs under their smaller face and the faces left alone in increasing order, a free state is INVALID_INDEX
+	size_t faceCount = mesh->getFaceCount();
+	std::vector<unsigned int> partners(faceCount);
+	for (size_t face = 0; face < faceCount; face++) {
+		partners[face] = states[face].load(std::memory_order_relaxed);
+	}
+	collectMatching(partners, matching, unmatchedFaces);
+}
+
+void WorkStealingMatching::addStatistics(std::map<std::string, double> &statistics) const {
+
+	// Store the totals and the counters of every worker
+	size_t claimCount = 0;
+	size_t claimConflictCount = 0;
+	size_t stealCount = 0;
+	for (unsigned int worker = 0; worker < workerCount; worker++) {
+		std::string prefix = "worker/" + std::to_string(worker) + "/";
+		statistics[prefix + "claimConflictCount"] = (double) claimConflictCounts[worker];
+		statistics[prefix + "stealCount"] = (double) stealCounts[worker];
+		claimCount += claimCounts[worker];
+		claimConflictCount += claimConflictCounts[worker];
+		stealCount += stealCounts[worker];
+	}
+	statistics["workerCount"] = (double) workerCount;
+	statistics["claimCount"] = (double) claimCount;
+	statistics["claimConflictCount"] = (double) claimConflictCount;
+	statistics["stealCount"] = (double) stealCount;
+}
+
+const std::vector<size_t>& WorkStealingMatching::getClaimConflictCounts() const {
+	return claimConflictCounts;
+}
+
+const std::vector<size_t>& WorkStealingMatching::getStealCounts() const {
+	return stealCounts;
+}
+
+bool WorkStealingMatching::findCandidate(unsigned int face, unsigned int &neighbor, double &value, bool &busy) const {
+
+	// Iterate through the neighbors that are free at the moment
+	neighbor = INVALID_INDEX;
+	value = 360;
+	busy = false;
+	unsigned int firstEdge = TriangularMesh::getHalfEdge(face);
+	for (unsigned int runner = firstEdge; runner < firstEdge + 3; runner++) {
+
+		// Boundary edges and matched neighbors cannot form a quadrilateral, locked neighbors may become free again
+		unsigned int twin = mesh->getTwin(runner);
+		if (twin == INVALID_INDEX) {
+			continue;
+		}
+		unsigned int pair = TriangularMesh::getFace(twin);
+		unsigned int state = states[pair].load(std::memory_order_acquire);
+		if (state == LOCKED_STATE) {
+			busy = true;
+		}
+		if (state != FREE_STATE) {
+			continue;
+		}
+
+		// Keep the neighbor with the smallest value, quadrilaterals without a value are never chosen
+		double currentValue = metricCache->getStoredMaximumWarpage(runner);
+		if (currentValue < value) {
+			value = currentValue;
+			neighbor = pair;
+		}
+	}
+
+	// Return true if a neighbor is found
+	return neighbor != INVALID_INDEX;
+}
+
+bool WorkStealingMatching::claimPair(unsigned int face, unsigned int neighbor) {
+
+	// Lock the smaller face
+	unsigned int first = std::min(face, neighbor);
+	unsigned int second = std::max(face, neighbor);
+	unsigned int expected = FREE_STATE;
+	if (!states[first].compare_exchange_strong(expected, LOCKED_STATE, std::memory_order_acq_rel)) {
+		return false;
+	}
+
+	// Claim the larger face for the smaller one, release the lock if it is taken
+	expected = FREE_STATE;
+	if (!states[second].compare_exchange_strong(expected, first, std::memory_order_acq_rel)) {
+		states[first].store(FREE_STATE, std::memory_order_release);
+		return false;
+	}
+
+	// Complete the pair
+	states[first].store(second, std::memory_order_release);
+	return true;
+}
+
+bool WorkStealingMatching::takeBlock(unsigned int worker, size_t &block, WorkerCounters &counters) {
+
+	// Take the next block of the own range
+	{
+		BlockRange &range = blockRanges[worker];
+		std::lock_guard<std::mutex> lock(range.mutex);
+		if (range.next < range.end) {
+			block = range.next++;
+			return true;
+		}
+	}
+
+	// Steal the last block of the next worker that has one left
+	for (unsigned int i = 1; i < workerCount; i++) {
+		BlockRange &range = blockRanges[(worker + i) % workerCount];
+		std::lock_guard<std::mutex> lock(range.mutex);
+		if (range.next < range.end) {
+			block = --range.end;
+			counters.stealCount++;
+			return true;
+		}
+	}
+
+	// Every block is taken
+	return false;
+}
+
+void WorkStealingMatching::matchBlock(size_t block, std::vector<FacePriority> &heap, WorkerCounters &counters) {
+
+	// Order the free faces of the block by their starting priorities
+	size_t first = block * STEALING_BLOCK_SIZE;
+	size_t last = std::min<size_t>(first + STEALING_BLOCK_SIZE, mesh->getFaceCount());
+	heap.clear();
+	for (size_t face = first; face < last; face++) {
+		if (priorities[face] < 360) {
+			heap.push_back({ priorities[face], (unsigned int) face });
+		}
+	}
+	std::make_heap(heap.begin(), heap.end(), MinPriorityOrder());
+
+	// Pop the faces and claim them with their best free neighbor
+	while (!heap.empty()) {
+		std::pop_heap(heap.begin(), heap.end(), MinPriorityOrder());
+		FacePriority entry = heap.back();
+		heap.pop_back();
+
+		// Skip the faces that are matched meanwhile, retry the ones locked by a claim in progress
+		unsigned int state = states[entry.face].load(std::memory_order_acquire);
+		if (state == LOCKED_STATE) {
+			heap.push_back(entry);
+			std::push_heap(heap.begin(), heap.end(), MinPriorityOrder());
+			continue;
+		}
+		if (state != FREE_STATE) {
+			continue;
+		}
+
+		// Find the best neighbor that is free now, the face stays unmatched if none can become free again
+		unsigned int neighbor;
+		double value;
+		bool busy;
+		if (!findCandidate(entry.face, neighbor, value, busy)) {
+			if (busy) {
+				heap.push_back(entry);
+				std::push_heap(heap.begin(), heap.end(), MinPriorityOrder());
+			}
+			continue;
+		}
+
+		// Insert the face again if its best neighbor got worse, another face of the block may be better now
+		if (value > entry.priority) {
+			heap.push_back({ value, entry.face });
+			std::push_heap(heap.begin(), heap.end(), MinPriorityOrder());
+			continue;
+		}
+
+		// Claim the pair, on a conflict the face is tried again with its new neighbors
+		if (claimPair(entry.face, neighbor)) {
+			counters.claimCount++;
+		} else {
+			counters.claimConflictCount++;
+			heap.push_back(entry);
+			std::push_heap(heap.begin(), heap.end(), MinPriorityOrder());
+		}
+	}
+}
@@ -0,0 +1,73 @@
+#ifndef WORK_STEALING_MATCHING
+#define WORK_STEALING_MATCHING
+
+#include "MatchingEngine.h"
+#include "Definitions.h"
+#include <atomic>
+#include <mutex>
+#include <memory>
+
+// Optimistic parallel matching, the faces are split into blocks and every worker owns a contiguous range of blocks
+// A worker orders the faces of a block with a local heap and claims a face pair with compare-and-swap on the face states
+// Idle workers steal blocks from the end of the ranges of the others, the matching depends on the timing of the threads
+class WorkStealingMatching : public MatchingEngine {
+public:
+
+	// Constructor
+	WorkStealingMatching(const TriangularMesh* mesh, EdgeMetricCache* metricCache);
+
+	void initialize();
+	void calculateMatching(std::map<unsigned int, unsigned int> &matching, std::vector<unsigned int> &unmatchedFaces);
+	void addStatistics(std::map<std::string, double> &statistics) const;
+
+	// Number of failed claims and stolen blocks of every worker
+	const std::vector<size_t>& getClaimConflictCounts() const;
+	const std::vector<size_t>& getStealCounts() const;
+
+private:
+
+	// Blocks that are not processed yet in the range of a worker, the owner takes from the front and thieves from the back
+	struct alignas(64) BlockRange {
+		std::mutex mutex;
+		size_t next;
+		size_t end;
+	};
+
+	// Counters of a worker, kept on its own thread while it runs
+	struct WorkerCounters {
+		size_t claimCount;
+		size_t claimConflictCount;
+		size_t stealCount;
+	};
+
+	// State of every face, the matched neighbor, FREE_STATE or LOCKED_STATE while a claim is in progress
+	std::unique_ptr<std::atomic<unsigned int>[]> states;
+
+	// Best candidate value of every face when the matching starts
+	std::vector<double> priorities;
+
+	// Block ranges of the workers
+	std::unique_ptr<BlockRange[]> blockRanges;
+	unsigned int workerCount;
+
+	// Counters of every worker
+	std::vector<size_t> claimCounts;
+	std::vector<size_t> claimConflictCounts;
+	std::vector<size_t> stealCounts;
+
+	// Finds the free neighbor with the best candidate quadrilateral, returns false if no neighbor can be claimed right now
+	// The busy flag is set if a neighbor is locked by a claim in progress
+	bool findCandidate(unsigned int face, unsigned int &neighbor, double &value, bool &busy) const;
+
+	// Claims the face pair, the smaller face is locked first so two claims never wait for each other
+	bool claimPair(unsigned int face, unsigned int neighbor);
+
+	// Takes the next block of the worker or steals one from another worker, returns false if no block is left
+	bool takeBlock(unsigned int worker, size_t &block, WorkerCounters &counters);
+
+	// Matches the faces of the block in the order of their candidate values
+	void matchBlock(size_t block, std::vector<FacePriority> &heap, WorkerCounters &counters);
+
+};
+
+#endif